@@ -0,0 +1,82 @@
+// Compare `memmove` and `tiny_stl::copy_nt` across copy sizes.
+//
+// For every size, the copy throughput is printed, along with the time to
+// re-read a small hot buffer after the copy. A copy much larger than the last
+// level cache evicts the hot buffer with `memmove`, but not with `copy_nt`.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+
+#include "algobase.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t kHotBytes = 1024 * 1024;
+constexpr size_t kMinBytes = 64 * 1024;
+constexpr size_t kMaxBytes = 256 * 1024 * 1024;
+constexpr size_t kBytesPerSize = 2048ull * 1024 * 1024;
+
+// Keeps the sums of the hot buffer alive.
+volatile long g_sink = 0;
+
+double seconds_since(clock_type::time_point start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// Sum the hot buffer, returns the time taken.
+double touch(const long *hot, size_t n) {
+  const auto start = clock_type::now();
+  g_sink = g_sink + std::accumulate(hot, hot + n, 0L);
+  return seconds_since(start);
+}
+
+template <class Copy>
+void run(const char *name, size_t bytes, const long *src, long *dest,
+         const long *hot, Copy copy) {
+  const size_t n = bytes / sizeof(long);
+  const size_t hot_n = kHotBytes / sizeof(long);
+  size_t rounds = kBytesPerSize / bytes;
+  if (rounds == 0) {
+    rounds = 1;
+  }
+  double copy_time = 0;
+  double touch_time = 0;
+  for (size_t r = 0; r < rounds; ++r) {
+    touch(hot, hot_n);
+    const auto start = clock_type::now();
+    copy(src, src + n, dest);
+    copy_time += seconds_since(start);
+    touch_time += touch(hot, hot_n);
+  }
+  std::printf("%-8s %10zu KiB %10.2f GB/s %10.1f us\n", name, bytes / 1024,
+              static_cast<double>(bytes) * rounds / copy_time / 1e9,
+              touch_time / rounds * 1e6);
+}
+
+} // namespace
+
+int main() {
+  std::unique_ptr<long[]> src(new long[kMaxBytes / sizeof(long)]);
+  std::unique_ptr<long[]> dest(new long[kMaxBytes / sizeof(long)]);
+  std::unique_ptr<long[]> hot(new long[kHotBytes / sizeof(long)]);
+  std::iota(src.get(), src.get() + kMaxBytes / sizeof(long), 0L);
+  std::memset(dest.get(), 1, kMaxBytes);
+  std::iota(hot.get(), hot.get() + kHotBytes / sizeof(long), 0L);
+
+  std::printf("%-8s %14s %15s %13s\n", "method", "size", "copy", "hot re-read");
+  for (size_t bytes = kMinBytes; bytes <= kMaxBytes; bytes *= 4) {
+    run("memmove", bytes, src.get(), dest.get(), hot.get(),
+        [](const long *first, const long *last, long *out) {
+          std::memmove(out, first, (last - first) * sizeof(long));
+        });
+    run("copy_nt", bytes, src.get(), dest.get(), hot.get(),
+        [](const long *first, const long *last, long *out) {
+          tiny_stl::copy_nt(first, last, out);
+        });
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+// Measure the scaling of `tiny_stl::sort(par, ...)` over 64-bit keys, next to
+// the sequential sorts.
+//
+// Usage: bench_sort [n] [max_threads]
+// The keys are sorted with 1, 2, 4, ... up to `max_threads` threads (64 by
+// default), after `std::sort`, the sequential `tiny_stl::sort` and the radix
+// sorts.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "algo.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since(clock_type::time_point start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+template <class Sort>
+double run(const std::vector<std::uint64_t> &keys, Sort sort) {
+  std::vector<std::uint64_t> data = keys;
+  const auto start = clock_type::now();
+  sort(data.data(), data.data() + data.size());
+  const double elapsed = seconds_since(start);
+  if (!std::is_sorted(data.begin(), data.end())) {
+    std::printf("error: the keys are not sorted\n");
+    std::exit(1);
+  }
+  return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 25;
+  const size_t max_threads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+  std::vector<std::uint64_t> keys(n);
+  std::mt19937_64 gen(42);
+  for (auto &key : keys) {
+    key = gen();
+  }
+
+  std::printf("%zu keys\n", n);
+  const double std_time = run(keys, [](std::uint64_t *first,
+                                       std::uint64_t *last) {
+    std::sort(first, last);
+  });
+  std::printf("%-16s %8.3f s\n", "std::sort", std_time);
+  const double seq_time = run(keys, [](std::uint64_t *first,
+                                       std::uint64_t *last) {
+    tiny_stl::sort(first, last);
+  });
+  std::printf("%-16s %8.3f s\n", "tiny_stl::sort", seq_time);
+  const double radix_time = run(keys, [](std::uint64_t *first,
+                                         std::uint64_t *last) {
+    tiny_stl::radix_sort(first, last);
+  });
+  std::printf("%-16s %8.3f s\n", "radix_sort", radix_time);
+  const double inplace_time = run(keys, [](std::uint64_t *first,
+                                           std::uint64_t *last) {
+    tiny_stl::inplace_radix_sort(first, last);
+  });
+  std::printf("%-16s %8.3f s\n", "inplace_radix", inplace_time);
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    tiny_stl::set_default_thread_count(threads);
+    const double time = run(keys, [](std::uint64_t *first,
+                                     std::uint64_t *last) {
+      tiny_stl::sort(tiny_stl::par, first, last);
+    });
+    std::printf("par %3zu threads  %8.3f s  speedup %5.2fx\n", threads, time,
+                seq_time / time);
+  }
+  return 0;
+}
@@ -0,0 +1,10 @@
+target("bench_copy_nt")
+    set_kind("binary")
+    add_files("copy_nt.cpp")
+target_end()
+
+target("bench_sort")
+    set_kind("binary")
+    add_files("sort.cpp")
+    add_syslinks("pthread")
+target_end()
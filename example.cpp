@@ -1,4 +1,5 @@
 #include <iostream>
+#include <iterator>
 
 #include <algorithm.hpp>
 #include <vector.hpp>
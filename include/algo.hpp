@@ -1,17 +1,314 @@
 #ifndef TINY_STL__INCLUDE__ALGO_HPP
 #define TINY_STL__INCLUDE__ALGO_HPP
 
+#include <cmath>
 #include <cstddef>
-#include <ctime>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "algobase.hpp"
+#include "allocator.hpp"
+#include "construct.hpp"
+#include "execution.hpp"
 #include "functional.hpp"
 #include "heap_algo.hpp"
 #include "iterator.hpp"
+#include "loser_tree.hpp"
 #include "memory.hpp"
+#include "random.hpp"
+#include "searcher.hpp"
 
 namespace tiny_stl {
 
+// Defined by "vector.hpp", which is included at the end of this file because
+// it depends on the algorithms here.
+template <class T> class vector;
+
+// The unsigned integer of `Size` bytes.
+template <size_t Size> struct uint_of_size;
+template <> struct uint_of_size<1> { using type = std::uint8_t; };
+template <> struct uint_of_size<2> { using type = std::uint16_t; };
+template <> struct uint_of_size<4> { using type = std::uint32_t; };
+template <> struct uint_of_size<8> { using type = std::uint64_t; };
+
+// The element types `find` and `count` compare a vector at a time when the
+// range is contiguous.
+template <class T>
+inline constexpr bool is_simd_searchable_v =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+     (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+      sizeof(T) == 8)) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Convert the searched value to the element type, fails when `*first ==
+// value` would not mean the same as comparing with the converted value.
+template <class T, class U> bool simd_search_value(const U &value, T &result) {
+  if constexpr (std::is_same_v<std::remove_cv_t<U>, T>) {
+    result = value;
+    return true;
+  } else if constexpr (std::is_integral_v<T> && std::is_integral_v<U> &&
+                       !std::is_same_v<U, bool>) {
+    result = static_cast<T>(value);
+    // The value must survive the round trip and keep its sign.
+    return static_cast<U>(result) == value && (value < U()) == (result < T());
+  } else if constexpr (std::is_same_v<T, double> && std::is_integral_v<U> &&
+                       !std::is_same_v<U, bool> && sizeof(U) <= 4) {
+    result = static_cast<double>(value);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+// `element == value` for the scalar loops of `find` and `count`, with the
+// usual arithmetic conversions made explicit so that mixing signed and
+// unsigned values does not warn.
+template <class T, class U>
+bool search_equal(const T &element, const U &value) {
+  if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<U>) {
+    using C = std::common_type_t<T, U>;
+    return static_cast<C>(element) == static_cast<C>(value);
+  } else {
+    return element == value;
+  }
+}
+
+#if defined(__SSE2__)
+template <class T> __m128i simd_broadcast128(T value) noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm_castps_si128(_mm_set1_ps(value));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm_castpd_si128(_mm_set1_pd(value));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_set1_epi8(static_cast<char>(value));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_set1_epi16(static_cast<short>(value));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_set1_epi32(static_cast<int>(value));
+  } else {
+    return _mm_set1_epi64x(static_cast<long long>(value));
+  }
+}
+
+// All the bytes of the lanes equal to `needle` are set.
+template <class T> __m128i simd_equal128(__m128i data, __m128i needle) {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm_castps_si128(
+        _mm_cmpeq_ps(_mm_castsi128_ps(data), _mm_castsi128_ps(needle)));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm_castpd_si128(
+        _mm_cmpeq_pd(_mm_castsi128_pd(data), _mm_castsi128_pd(needle)));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_cmpeq_epi8(data, needle);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_cmpeq_epi16(data, needle);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_cmpeq_epi32(data, needle);
+  } else {
+    // SSE2 has no 64-bit compare, both 32-bit halves must be equal.
+    const __m128i half = _mm_cmpeq_epi32(data, needle);
+    return _mm_and_si128(half,
+                         _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+}
+
+template <class T> __m128i simd_subtract128(__m128i left, __m128i right) {
+  if constexpr (sizeof(T) == 1) {
+    return _mm_sub_epi8(left, right);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_sub_epi16(left, right);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_sub_epi32(left, right);
+  } else {
+    return _mm_sub_epi64(left, right);
+  }
+}
+#endif
+
+#if defined(__AVX2__)
+template <class T> __m256i simd_broadcast256(T value) noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_set1_ps(value));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_set1_pd(value));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_set1_epi8(static_cast<char>(value));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_set1_epi16(static_cast<short>(value));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_set1_epi32(static_cast<int>(value));
+  } else {
+    return _mm256_set1_epi64x(static_cast<long long>(value));
+  }
+}
+
+template <class T> __m256i simd_equal256(__m256i data, __m256i needle) {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(data),
+                                             _mm256_castsi256_ps(needle),
+                                             _CMP_EQ_OQ));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(data),
+                                             _mm256_castsi256_pd(needle),
+                                             _CMP_EQ_OQ));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_cmpeq_epi8(data, needle);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_cmpeq_epi16(data, needle);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_cmpeq_epi32(data, needle);
+  } else {
+    return _mm256_cmpeq_epi64(data, needle);
+  }
+}
+
+template <class T> __m256i simd_subtract256(__m256i left, __m256i right) {
+  if constexpr (sizeof(T) == 1) {
+    return _mm256_sub_epi8(left, right);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_sub_epi16(left, right);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_sub_epi32(left, right);
+  } else {
+    return _mm256_sub_epi64(left, right);
+  }
+}
+#endif
+
+// The index of the first element equal to `value`, `n` if there is none.
+// Bytes are searched by `memchr`, the other types four vectors at a time.
+template <class T>
+size_t simd_find_index(const T *data, size_t n, T value) noexcept {
+  if constexpr (std::is_integral_v<T> && sizeof(T) == 1) {
+    const void *hit = std::memchr(data, static_cast<unsigned char>(value), n);
+    return hit ? static_cast<size_t>(static_cast<const T *>(hit) - data) : n;
+  } else {
+    size_t i = 0;
+#if defined(__AVX2__)
+    constexpr size_t lanes = 32 / sizeof(T);
+    const __m256i needle = tiny_stl::simd_broadcast256(value);
+    const auto load = [data](size_t at) {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + at));
+    };
+    for (; i + 4 * lanes <= n; i += 4 * lanes) {
+      const __m256i eq0 = tiny_stl::simd_equal256<T>(load(i), needle);
+      const __m256i eq1 = tiny_stl::simd_equal256<T>(load(i + lanes), needle);
+      const __m256i eq2 =
+          tiny_stl::simd_equal256<T>(load(i + 2 * lanes), needle);
+      const __m256i eq3 =
+          tiny_stl::simd_equal256<T>(load(i + 3 * lanes), needle);
+      const __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1),
+                                          _mm256_or_si256(eq2, eq3));
+      if (_mm256_movemask_epi8(any) != 0) {
+        break;
+      }
+    }
+    for (; i + lanes <= n; i += lanes) {
+      const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+          tiny_stl::simd_equal256<T>(load(i), needle)));
+      if (mask != 0) {
+        return i + static_cast<size_t>(__builtin_ctz(mask)) / sizeof(T);
+      }
+    }
+#elif defined(__SSE2__)
+    constexpr size_t lanes = 16 / sizeof(T);
+    const __m128i needle = tiny_stl::simd_broadcast128(value);
+    const auto load = [data](size_t at) {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + at));
+    };
+    for (; i + 4 * lanes <= n; i += 4 * lanes) {
+      const __m128i eq0 = tiny_stl::simd_equal128<T>(load(i), needle);
+      const __m128i eq1 = tiny_stl::simd_equal128<T>(load(i + lanes), needle);
+      const __m128i eq2 =
+          tiny_stl::simd_equal128<T>(load(i + 2 * lanes), needle);
+      const __m128i eq3 =
+          tiny_stl::simd_equal128<T>(load(i + 3 * lanes), needle);
+      const __m128i any =
+          _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+      if (_mm_movemask_epi8(any) != 0) {
+        break;
+      }
+    }
+    for (; i + lanes <= n; i += lanes) {
+      const auto mask = static_cast<unsigned>(
+          _mm_movemask_epi8(tiny_stl::simd_equal128<T>(load(i), needle)));
+      if (mask != 0) {
+        return i + static_cast<size_t>(__builtin_ctz(mask)) / sizeof(T);
+      }
+    }
+#endif
+    for (; i < n; ++i) {
+      if (data[i] == value) {
+        return i;
+      }
+    }
+    return n;
+  }
+}
+
+// The number of elements equal to `value`. Each compare result is -1 in the
+// matching lanes, subtracting it counts the matches lane by lane, and the lane
+// counters are summed before they can overflow.
+template <class T>
+size_t simd_count(const T *data, size_t n, T value) noexcept {
+  using Counter = typename uint_of_size<sizeof(T)>::type;
+  constexpr size_t max_rounds = sizeof(T) == 1 ? 255 : 65535;
+  size_t result = 0;
+  size_t i = 0;
+#if defined(__AVX2__)
+  constexpr size_t lanes = 32 / sizeof(T);
+  const __m256i needle = tiny_stl::simd_broadcast256(value);
+  while (i + lanes <= n) {
+    const size_t rounds = (n - i) / lanes;
+    const size_t stop = i + (rounds < max_rounds ? rounds : max_rounds) * lanes;
+    __m256i counters = _mm256_setzero_si256();
+    for (; i < stop; i += lanes) {
+      const __m256i eq = tiny_stl::simd_equal256<T>(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)),
+          needle);
+      counters = tiny_stl::simd_subtract256<T>(counters, eq);
+    }
+    Counter sums[lanes];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), counters);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      result += sums[lane];
+    }
+  }
+#elif defined(__SSE2__)
+  constexpr size_t lanes = 16 / sizeof(T);
+  const __m128i needle = tiny_stl::simd_broadcast128(value);
+  while (i + lanes <= n) {
+    const size_t rounds = (n - i) / lanes;
+    const size_t stop = i + (rounds < max_rounds ? rounds : max_rounds) * lanes;
+    __m128i counters = _mm_setzero_si128();
+    for (; i < stop; i += lanes) {
+      const __m128i eq = tiny_stl::simd_equal128<T>(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)),
+          needle);
+      counters = tiny_stl::simd_subtract128<T>(counters, eq);
+    }
+    Counter sums[lanes];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sums), counters);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      result += sums[lane];
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (data[i] == value) {
+      ++result;
+    }
+  }
+  return result;
+}
+
 template <class InputIter, class UnaryPredict>
 bool all_of(InputIter first, InputIter last, UnaryPredict unary_predict) {
   for (; first != last; ++first) {
@@ -44,9 +341,18 @@ bool none_of(InputIter first, InputIter last, UnaryPredict unary_predict) {
 
 template <class InputIter, class T>
 size_t count(InputIter first, InputIter last, const T &value) {
+  using V = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<InputIter> &&
+                tiny_stl::is_simd_searchable_v<V>) {
+    V needle;
+    if (first != last && tiny_stl::simd_search_value(value, needle)) {
+      return tiny_stl::simd_count(tiny_stl::to_address(first),
+                                  static_cast<size_t>(last - first), needle);
+    }
+  }
   size_t result = 0;
   for (; first != last; ++first) {
-    if (*first == value) {
+    if (tiny_stl::search_equal(*first, value)) {
       ++result;
     }
   }
@@ -66,7 +372,17 @@ size_t count_if(InputIter first, InputIter last, UnaryPredict unary_predict) {
 
 template <class InputIter, class T>
 InputIter find(InputIter first, InputIter last, const T &value) {
-  while (first != last && (*first) != value) {
+  using V = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<InputIter> &&
+                tiny_stl::is_simd_searchable_v<V>) {
+    V needle;
+    if (first != last && tiny_stl::simd_search_value(value, needle)) {
+      return first + tiny_stl::simd_find_index(
+                         tiny_stl::to_address(first),
+                         static_cast<size_t>(last - first), needle);
+    }
+  }
+  while (first != last && !tiny_stl::search_equal(*first, value)) {
     ++first;
   }
   return first;
@@ -92,6 +408,19 @@ InputIter find_if_not(InputIter first, InputIter last,
 template <class ForwardIter1, class ForwardIter2>
 ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
                     ForwardIter2 first2, ForwardIter2 last2) {
+  using V1 = std::remove_cv_t<std::remove_reference_t<decltype(*first1)>>;
+  using V2 = std::remove_cv_t<std::remove_reference_t<decltype(*first2)>>;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<ForwardIter1> &&
+                tiny_stl::is_contiguous_iterator_v<ForwardIter2> &&
+                tiny_stl::is_searchable_byte_v<V1> && std::is_same_v<V1, V2>) {
+    const auto n = static_cast<size_t>(last1 - first1);
+    const size_t pos = tiny_stl::search_bytes(
+        reinterpret_cast<const unsigned char *>(tiny_stl::to_address(first1)),
+        n,
+        reinterpret_cast<const unsigned char *>(tiny_stl::to_address(first2)),
+        static_cast<size_t>(last2 - first2));
+    return first1 + pos;
+  }
   auto d1 = distance(first1, last1);
   auto d2 = distance(first2, last2);
   if (d1 < d2) {
@@ -145,6 +474,12 @@ ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
   return first1;
 }
 
+template <class ForwardIter, class Searcher>
+ForwardIter search(ForwardIter first, ForwardIter last,
+                   const Searcher &searcher) {
+  return searcher(first, last).first;
+}
+
 template <class ForwardIter, class Size, class T>
 ForwardIter search_n(ForwardIter first, ForwardIter last, Size n,
                      const T &value) {
@@ -373,6 +708,66 @@ ForwardIter adjacent_find(ForwardIter first, ForwardIter last,
   return last;
 }
 
+// Binary searches prefetch their next probes while the range left is larger
+// than this, about the size of the L2 cache.
+constexpr static size_t kBranchlessPrefetchBytes = 1 << 18;
+
+// Binary searches over random-access ranges of arithmetic values or pointers
+// use `branchless_bound`.
+template <class RandomIter,
+          class V = std::remove_cv_t<std::remove_reference_t<
+              decltype(*std::declval<RandomIter>())>>>
+inline constexpr bool is_branchless_searchable_v =
+    std::is_arithmetic_v<V> || std::is_pointer_v<V>;
+
+template <bool Upper, class RandomIter, class Distance, class T,
+          class Compared>
+inline Distance branchless_step(RandomIter first, Distance base, Distance half,
+                                const T &value, Compared &comp) {
+  bool right;
+  if constexpr (Upper)
+    right = !comp(value, first[base + half]);
+  else
+    right = comp(first[base + half], value);
+  return right ? base + half : base;
+}
+
+// Branchless binary search: the range shrinks by half on every step whatever
+// the comparison says, the comparison only picks which half by a conditional
+// move, and the two possible probes of the next step are prefetched, so the
+// cache misses of the two paths overlap instead of waiting for the branch.
+template <bool Upper, class RandomIter, class T, class Compared>
+RandomIter branchless_bound(RandomIter first, RandomIter last, const T &value,
+                            Compared &comp) {
+  using Distance = decltype(last - first);
+  Distance len = last - first;
+  if (len == 0)
+    return first;
+  Distance base = 0;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<RandomIter>) {
+    // Prefetching only pays while the range is larger than the cache, on a
+    // cached range the extra instructions cost more than they save.
+    const auto *data = tiny_stl::to_address(first);
+    const Distance cached =
+        kBranchlessPrefetchBytes / static_cast<Distance>(sizeof(*data));
+    while (len > cached) {
+      const Distance half = len / 2;
+      len -= half;
+      __builtin_prefetch(data + base + len / 2);
+      __builtin_prefetch(data + base + half + len / 2);
+      base = tiny_stl::branchless_step<Upper>(first, base, half, value, comp);
+    }
+  }
+  while (len > 1) {
+    const Distance half = len / 2;
+    len -= half;
+    base = tiny_stl::branchless_step<Upper>(first, base, half, value, comp);
+  }
+  const bool after =
+      Upper ? !comp(value, first[base]) : comp(first[base], value);
+  return first + (base + after);
+}
+
 template <class ForwardIter, class T>
 ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last, const T &value,
                             forward_iterator_tag) {
@@ -397,6 +792,10 @@ ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last, const T &value,
 template <class RandomAccessIter, class T>
 RandomAccessIter lbound_dispatch(RandomAccessIter first, RandomAccessIter last,
                                  const T &value, random_access_iterator_tag) {
+  if constexpr (is_branchless_searchable_v<RandomAccessIter>) {
+    auto comp = [](const auto &x, const auto &y) { return x < y; };
+    return tiny_stl::branchless_bound<false>(first, last, value, comp);
+  }
   auto len = last - first;
   auto half = len;
   RandomAccessIter middle;
@@ -442,6 +841,8 @@ ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last, const T &value,
 template <class RandomIter, class T, class Compare>
 RandomIter lbound_dispatch(RandomIter first, RandomIter last, const T &value,
                            random_access_iterator_tag, Compare compare) {
+  if constexpr (is_branchless_searchable_v<RandomIter>)
+    return tiny_stl::branchless_bound<false>(first, last, value, compare);
   auto len = last - first;
   auto half = len;
   RandomIter middle;
@@ -489,6 +890,10 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last, const T &value,
 template <class RandomIter, class T>
 RandomIter ubound_dispatch(RandomIter first, RandomIter last, const T &value,
                            random_access_iterator_tag) {
+  if constexpr (is_branchless_searchable_v<RandomIter>) {
+    auto comp = [](const auto &x, const auto &y) { return x < y; };
+    return tiny_stl::branchless_bound<true>(first, last, value, comp);
+  }
   auto len = last - first;
   auto half = len;
   RandomIter middle;
@@ -535,6 +940,8 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last, const T &value,
 template <class RandomIter, class T, class Compare>
 RandomIter ubound_dispatch(RandomIter first, RandomIter last, const T &value,
                            random_access_iterator_tag, Compare compare) {
+  if constexpr (is_branchless_searchable_v<RandomIter>)
+    return tiny_stl::branchless_bound<true>(first, last, value, compare);
   auto len = last - first;
   auto half = len;
   RandomIter middle;
@@ -567,7 +974,7 @@ bool binary_search(ForwardIter first, ForwardIter last, const T &value) {
 template <class ForwardIter, class T, class Compare>
 bool binary_search(ForwardIter first, ForwardIter last, const T &value,
                    Compare compare) {
-  auto iter = tiny_stl::lower_bound(first, last, value);
+  auto iter = tiny_stl::lower_bound(first, last, value, compare);
   return iter != last && !compare(value, *iter);
 }
 
@@ -604,6 +1011,12 @@ template <class RandomIter, class T>
 tiny_stl::pair<RandomIter, RandomIter>
 erange_dispatch(RandomIter first, RandomIter last, const T &value,
                 random_access_iterator_tag) {
+  if constexpr (is_branchless_searchable_v<RandomIter>) {
+    auto comp = [](const auto &x, const auto &y) { return x < y; };
+    auto left = tiny_stl::branchless_bound<false>(first, last, value, comp);
+    auto right = tiny_stl::branchless_bound<true>(left, last, value, comp);
+    return tiny_stl::pair<RandomIter, RandomIter>(left, right);
+  }
   auto len = last - first;
   auto half = len;
   RandomIter middle, left, right;
@@ -663,6 +1076,11 @@ template <class RandomIter, class T, class Compare>
 tiny_stl::pair<RandomIter, RandomIter>
 erange_dispatch(RandomIter first, RandomIter last, const T &value,
                 random_access_iterator_tag, Compare compare) {
+  if constexpr (is_branchless_searchable_v<RandomIter>) {
+    auto left = tiny_stl::branchless_bound<false>(first, last, value, compare);
+    auto right = tiny_stl::branchless_bound<true>(left, last, value, compare);
+    return tiny_stl::pair<RandomIter, RandomIter>(left, right);
+  }
   auto len = last - first;
   auto half = len;
   RandomIter middle, left, right;
@@ -691,6 +1109,165 @@ equal_range(ForwardIter first, ForwardIter last, const T &value,
                                    compare);
 }
 
+// Exponential search from the front, then binary search, for the same result
+// as `lower_bound` (or `upper_bound` with `Upper`) when the answer is near
+// `first`.
+template <bool Upper, class RandomIter, class T, class Compared>
+RandomIter gallop_bound(RandomIter first, RandomIter last, const T &value,
+                        Compared &comp) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  const Distance n = last - first;
+  // Only the comparison of the bound searched is instantiated, so a
+  // comparator may take its arguments in that order only.
+  const auto before = [&](Distance i) {
+    if constexpr (Upper)
+      return !comp(value, first[i]);
+    else
+      return static_cast<bool>(comp(first[i], value));
+  };
+  Distance bound = 1;
+  while (bound <= n && before(bound - 1)) {
+    bound *= 2;
+  }
+  const auto lo = first + bound / 2;
+  const auto hi = first + (bound - 1 < n ? bound - 1 : n);
+  if constexpr (Upper)
+    return tiny_stl::upper_bound(lo, hi, value, comp);
+  else
+    return tiny_stl::lower_bound(lo, hi, value, comp);
+}
+
+// Keys searched side by side by `lower_bound_batch`, enough for their cache
+// misses to overlap.
+constexpr static size_t kLowerBoundBatchSize = 16;
+
+// Search a group of keys at a time: every key of a group takes the same
+// number of halving steps, so the steps are interleaved, and the next probe of
+// each key is prefetched before the next level is searched.
+template <class RandomIter, class ForwardIter, class OutputIter, class Compared>
+OutputIter lbound_batch_interleaved(RandomIter first, RandomIter last,
+                                    ForwardIter keys_first,
+                                    ForwardIter keys_last, OutputIter out,
+                                    Compared &comp) {
+  using Distance = decltype(last - first);
+  const Distance n = last - first;
+  bool prefetch = false;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<RandomIter>) {
+    prefetch = n > static_cast<Distance>(kBranchlessPrefetchBytes /
+                                         sizeof(*tiny_stl::to_address(first)));
+  }
+  ForwardIter keys[kLowerBoundBatchSize];
+  Distance bases[kLowerBoundBatchSize];
+  while (keys_first != keys_last) {
+    size_t count = 0;
+    for (; count < kLowerBoundBatchSize && keys_first != keys_last;
+         ++count, ++keys_first) {
+      keys[count] = keys_first;
+      bases[count] = 0;
+    }
+    if (n == 0) {
+      for (size_t i = 0; i < count; ++i, ++out)
+        *out = first;
+      continue;
+    }
+    Distance len = n;
+    while (len > 1) {
+      const Distance half = len / 2;
+      len -= half;
+      for (size_t i = 0; i < count; ++i) {
+        bases[i] = tiny_stl::branchless_step<false>(first, bases[i], half,
+                                                    *keys[i], comp);
+      }
+      if constexpr (tiny_stl::is_contiguous_iterator_v<RandomIter>) {
+        if (prefetch) {
+          const auto *data = tiny_stl::to_address(first);
+          for (size_t i = 0; i < count; ++i)
+            __builtin_prefetch(data + bases[i] + len / 2);
+        }
+      }
+    }
+    for (size_t i = 0; i < count; ++i, ++out)
+      *out = first + (bases[i] + comp(first[bases[i]], *keys[i]));
+  }
+  return out;
+}
+
+// Search sorted keys like a merge: every search gallops from the result of
+// the previous key, so close keys cost a few compares and the whole batch
+// costs no more than `O(m log(n / m))`.
+template <class RandomIter, class ForwardIter, class OutputIter, class Compared>
+OutputIter lbound_batch_sorted(RandomIter first, RandomIter last,
+                               ForwardIter keys_first, ForwardIter keys_last,
+                               OutputIter out, Compared &comp) {
+  for (; keys_first != keys_last; ++keys_first, ++out) {
+    first = tiny_stl::gallop_bound<false>(first, last, *keys_first, comp);
+    *out = first;
+  }
+  return out;
+}
+
+template <class ForwardIter1, class ForwardIter2, class OutputIter,
+          class Compared>
+OutputIter lbound_batch_dispatch(ForwardIter1 first, ForwardIter1 last,
+                                 ForwardIter2 keys_first,
+                                 ForwardIter2 keys_last, OutputIter out,
+                                 forward_iterator_tag, Compared &comp) {
+  for (; keys_first != keys_last; ++keys_first, ++out)
+    *out = tiny_stl::lower_bound(first, last, *keys_first, comp);
+  return out;
+}
+
+template <class RandomIter, class ForwardIter, class OutputIter,
+          class Compared>
+OutputIter lbound_batch_dispatch(RandomIter first, RandomIter last,
+                                 ForwardIter keys_first, ForwardIter keys_last,
+                                 OutputIter out, random_access_iterator_tag,
+                                 Compared &comp) {
+  // Sorted keys are only recognized when they can be compared with each
+  // other, a comparator taking an element and a key may not take two keys.
+  using Key = decltype(*keys_first);
+  bool sorted = false;
+  if constexpr (std::is_invocable_r_v<bool, Compared &, Key, Key>) {
+    sorted = true;
+    if (keys_first != keys_last) {
+      auto prev = keys_first;
+      auto next = prev;
+      for (++next; sorted && next != keys_last; prev = next, ++next)
+        sorted = !comp(*next, *prev);
+    }
+  }
+  if (sorted) {
+    return tiny_stl::lbound_batch_sorted(first, last, keys_first, keys_last,
+                                         out, comp);
+  }
+  return tiny_stl::lbound_batch_interleaved(first, last, keys_first,
+                                            keys_last, out, comp);
+}
+
+// Write `lower_bound(first, last, key)` of every key of [keys_first,
+// keys_last) to `out`, in the order of the keys. The comparator needs only
+// take an element and a key, as for `lower_bound`; when it also takes two
+// keys, sorted keys are searched like a merge. A generic lambda must then
+// compile for two keys, or constrain its parameters.
+template <class ForwardIter1, class ForwardIter2, class OutputIter>
+OutputIter lower_bound_batch(ForwardIter1 first, ForwardIter1 last,
+                             ForwardIter2 keys_first, ForwardIter2 keys_last,
+                             OutputIter out) {
+  auto comp = [](const auto &x, const auto &y) { return x < y; };
+  return tiny_stl::lbound_batch_dispatch(first, last, keys_first, keys_last,
+                                         out, iterator_category(first), comp);
+}
+
+template <class ForwardIter1, class ForwardIter2, class OutputIter,
+          class Compare>
+OutputIter lower_bound_batch(ForwardIter1 first, ForwardIter1 last,
+                             ForwardIter2 keys_first, ForwardIter2 keys_last,
+                             OutputIter out, Compare compare) {
+  return tiny_stl::lbound_batch_dispatch(first, last, keys_first, keys_last,
+                                         out, iterator_category(first),
+                                         compare);
+}
+
 template <class ForwardIter, class Generator>
 void generate(ForwardIter first, ForwardIter last, Generator generator) {
   for (; first != last; ++first) {
@@ -735,6 +1312,349 @@ bool includes(InputIter1 first1, InputIter1 last1, InputIter2 first2,
   return first2 == last2;
 }
 
+// An input this many times longer than the other is galloped through by
+// `set_intersection` and `set_difference` instead of being merged.
+constexpr static size_t kSetGallopRatio = 16;
+
+// Whether one of the ranges is long enough to be galloped through.
+template <class InputIter1, class InputIter2>
+bool set_should_gallop(InputIter1 first1, InputIter1 last1,
+                       InputIter2 first2, InputIter2 last2) {
+  if constexpr (tiny_stl::is_random_iterator<InputIter1>::value &&
+                tiny_stl::is_random_iterator<InputIter2>::value) {
+    const auto len1 = static_cast<size_t>(last1 - first1);
+    const auto len2 = static_cast<size_t>(last2 - first2);
+    return len1 / kSetGallopRatio > len2 || len2 / kSetGallopRatio > len1;
+  } else {
+    return false;
+  }
+}
+
+// Where `set_intersection` puts the elements it keeps: copied to the output.
+template <class OutputIter> struct set_copy_sink {
+  OutputIter out;
+
+  template <class Iter> void operator()(Iter it) {
+    *out = *it;
+    ++out;
+  }
+
+  // The elements of `block` whose bits are set in `mask`.
+  template <class T> void operator()(const T *block, unsigned mask) {
+    for (; mask != 0; mask &= mask - 1) {
+      *out = block[__builtin_ctz(mask)];
+      ++out;
+    }
+  }
+};
+
+// Where `set_intersection_size` puts the elements it keeps: counted.
+struct set_count_sink {
+  size_t count = 0;
+
+  template <class Iter> void operator()(Iter) { ++count; }
+
+  template <class T> void operator()(const T *, unsigned mask) {
+    count += static_cast<size_t>(__builtin_popcount(mask));
+  }
+};
+
+// Whether `set_intersection` compares the elements 4 by 4 with vector
+// compares, which it does for 4-byte integers in contiguous ranges.
+template <class Iter1, class Iter2> constexpr bool is_simd_intersectable() {
+  if constexpr (tiny_stl::is_contiguous_iterator_v<Iter1> &&
+                tiny_stl::is_contiguous_iterator_v<Iter2>) {
+    using T1 = std::remove_cv_t<
+        std::remove_reference_t<decltype(*std::declval<Iter1>())>>;
+    using T2 = std::remove_cv_t<
+        std::remove_reference_t<decltype(*std::declval<Iter2>())>>;
+    return std::is_same_v<T1, T2> && std::is_integral_v<T1> &&
+           sizeof(T1) == 4;
+  } else {
+    return false;
+  }
+}
+
+#if defined(__SSE2__)
+// Intersect a block of 4 of `a` with a block of 4 of `b` at a time: `a` is
+// compared with the 4 rotations of `b`, and the block ending first is left.
+// Stops at a repeated value, which the blocks would count too often, and
+// leaves the rest to the scalar loop.
+template <class T, class Sink>
+void simd_intersect32(const T *&a, const T *a_end, const T *&b,
+                      const T *b_end, Sink &sink) {
+  while (a_end - a > 4 && b_end - b > 4) {
+    const auto *pa = reinterpret_cast<const __m128i *>(a);
+    const auto *pb = reinterpret_cast<const __m128i *>(b);
+    const __m128i va = _mm_loadu_si128(pa);
+    const __m128i vb = _mm_loadu_si128(pb);
+    const __m128i repeated = _mm_or_si128(
+        _mm_cmpeq_epi32(va, _mm_loadu_si128(
+                                reinterpret_cast<const __m128i *>(a + 1))),
+        _mm_cmpeq_epi32(vb, _mm_loadu_si128(
+                                reinterpret_cast<const __m128i *>(b + 1))));
+    if (_mm_movemask_epi8(repeated) != 0)
+      break;
+    const __m128i vb1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    const __m128i vb2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+    const __m128i vb3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+    const __m128i equal = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, vb1)),
+        _mm_or_si128(_mm_cmpeq_epi32(va, vb2), _mm_cmpeq_epi32(va, vb3)));
+    const auto mask =
+        static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+    if (mask != 0)
+      sink(a, mask);
+    const T a_max = a[3];
+    const T b_max = b[3];
+    a += a_max <= b_max ? 4 : 0;
+    b += b_max <= a_max ? 4 : 0;
+  }
+}
+#endif
+
+// The elements of the first range also in the second, passed to `sink`.
+// `Natural` tells that `comp` is `operator<`, which the vector compares of
+// the 4-byte integers assume.
+template <bool Natural, class InputIter1, class InputIter2, class Sink,
+          class Compared>
+void set_intersection_loop(InputIter1 first1, InputIter1 last1,
+                           InputIter2 first2, InputIter2 last2, Sink &sink,
+                           Compared &comp) {
+  if (tiny_stl::set_should_gallop(first1, last1, first2, last2)) {
+    if constexpr (tiny_stl::is_random_iterator<InputIter1>::value &&
+                  tiny_stl::is_random_iterator<InputIter2>::value) {
+      if (last1 - first1 < last2 - first2) {
+        for (; first1 != last1; ++first1) {
+          first2 = tiny_stl::gallop_bound<false>(first2, last2, *first1, comp);
+          if (first2 == last2)
+            return;
+          if (!comp(*first1, *first2)) {
+            sink(first1);
+            ++first2;
+          }
+        }
+      } else {
+        for (; first2 != last2; ++first2) {
+          first1 = tiny_stl::gallop_bound<false>(first1, last1, *first2, comp);
+          if (first1 == last1)
+            return;
+          if (!comp(*first2, *first1)) {
+            sink(first1);
+            ++first1;
+          }
+        }
+      }
+      return;
+    }
+  }
+#if defined(__SSE2__)
+  if constexpr (Natural &&
+                tiny_stl::is_simd_intersectable<InputIter1, InputIter2>()) {
+    const auto *a = tiny_stl::to_address(first1);
+    const auto *b = tiny_stl::to_address(first2);
+    const auto *a_begin = a;
+    const auto *b_begin = b;
+    tiny_stl::simd_intersect32(a, a + (last1 - first1), b,
+                               b + (last2 - first2), sink);
+    first1 += a - a_begin;
+    first2 += b - b_begin;
+  }
+#endif
+  while (first1 != last1 && first2 != last2) {
+    if (comp(*first1, *first2)) {
+      ++first1;
+    } else if (comp(*first2, *first1)) {
+      ++first2;
+    } else {
+      sink(first1);
+      ++first1, ++first2;
+    }
+  }
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+                            InputIter2 first2, InputIter2 last2,
+                            OutputIter result) {
+  auto comp = [](const auto &x, const auto &y) { return x < y; };
+  tiny_stl::set_copy_sink<OutputIter> sink{result};
+  tiny_stl::set_intersection_loop<true>(first1, last1, first2, last2, sink,
+                                        comp);
+  return sink.out;
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class Compared>
+OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+                            InputIter2 first2, InputIter2 last2,
+                            OutputIter result, Compared comp) {
+  tiny_stl::set_copy_sink<OutputIter> sink{result};
+  tiny_stl::set_intersection_loop<false>(first1, last1, first2, last2, sink,
+                                         comp);
+  return sink.out;
+}
+
+// The size of `set_intersection` without writing it.
+template <class InputIter1, class InputIter2>
+size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                             InputIter2 first2, InputIter2 last2) {
+  auto comp = [](const auto &x, const auto &y) { return x < y; };
+  tiny_stl::set_count_sink sink;
+  tiny_stl::set_intersection_loop<true>(first1, last1, first2, last2, sink,
+                                        comp);
+  return sink.count;
+}
+
+template <class InputIter1, class InputIter2, class Compared>
+size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                             InputIter2 first2, InputIter2 last2,
+                             Compared comp) {
+  tiny_stl::set_count_sink sink;
+  tiny_stl::set_intersection_loop<false>(first1, last1, first2, last2, sink,
+                                         comp);
+  return sink.count;
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class Compared>
+OutputIter set_difference_loop(InputIter1 first1, InputIter1 last1,
+                               InputIter2 first2, InputIter2 last2,
+                               OutputIter result, Compared &comp) {
+  if (tiny_stl::set_should_gallop(first1, last1, first2, last2)) {
+    if constexpr (tiny_stl::is_random_iterator<InputIter1>::value &&
+                  tiny_stl::is_random_iterator<InputIter2>::value) {
+      if (last1 - first1 < last2 - first2) {
+        for (; first1 != last1; ++first1) {
+          first2 = tiny_stl::gallop_bound<false>(first2, last2, *first1, comp);
+          if (first2 != last2 && !comp(*first1, *first2)) {
+            ++first2;
+          } else {
+            *result = *first1;
+            ++result;
+          }
+        }
+        return result;
+      }
+      // Copy the runs of the first range between the elements of the second
+      // a block at a time.
+      for (; first2 != last2 && first1 != last1; ++first2) {
+        auto cut = tiny_stl::gallop_bound<false>(first1, last1, *first2, comp);
+        result = tiny_stl::copy(first1, cut, result);
+        first1 = cut;
+        if (first1 != last1 && !comp(*first2, *first1))
+          ++first1;
+      }
+      return tiny_stl::copy(first1, last1, result);
+    }
+  }
+  while (first1 != last1 && first2 != last2) {
+    if (comp(*first1, *first2)) {
+      *result = *first1;
+      ++first1, ++result;
+    } else if (comp(*first2, *first1)) {
+      ++first2;
+    } else {
+      ++first1, ++first2;
+    }
+  }
+  return tiny_stl::copy(first1, last1, result);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_difference(InputIter1 first1, InputIter1 last1,
+                          InputIter2 first2, InputIter2 last2,
+                          OutputIter result) {
+  auto comp = [](const auto &x, const auto &y) { return x < y; };
+  return tiny_stl::set_difference_loop(first1, last1, first2, last2, result,
+                                       comp);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class Compared>
+OutputIter set_difference(InputIter1 first1, InputIter1 last1,
+                          InputIter2 first2, InputIter2 last2,
+                          OutputIter result, Compared comp) {
+  return tiny_stl::set_difference_loop(first1, last1, first2, last2, result,
+                                       comp);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_union(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                     InputIter2 last2, OutputIter result) {
+  while (first1 != last1 && first2 != last2) {
+    if (*first1 < *first2) {
+      *result = *first1;
+      ++first1;
+    } else if (*first2 < *first1) {
+      *result = *first2;
+      ++first2;
+    } else {
+      *result = *first1;
+      ++first1, ++first2;
+    }
+    ++result;
+  }
+  return tiny_stl::copy(first2, last2, tiny_stl::copy(first1, last1, result));
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class Compared>
+OutputIter set_union(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                     InputIter2 last2, OutputIter result, Compared comp) {
+  while (first1 != last1 && first2 != last2) {
+    if (comp(*first1, *first2)) {
+      *result = *first1;
+      ++first1;
+    } else if (comp(*first2, *first1)) {
+      *result = *first2;
+      ++first2;
+    } else {
+      *result = *first1;
+      ++first1, ++first2;
+    }
+    ++result;
+  }
+  return tiny_stl::copy(first2, last2, tiny_stl::copy(first1, last1, result));
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1,
+                                    InputIter2 first2, InputIter2 last2,
+                                    OutputIter result) {
+  while (first1 != last1 && first2 != last2) {
+    if (*first1 < *first2) {
+      *result = *first1;
+      ++first1, ++result;
+    } else if (*first2 < *first1) {
+      *result = *first2;
+      ++first2, ++result;
+    } else {
+      ++first1, ++first2;
+    }
+  }
+  return tiny_stl::copy(first2, last2, tiny_stl::copy(first1, last1, result));
+}
+
+template <class InputIter1, class InputIter2, class OutputIter,
+          class Compared>
+OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1,
+                                    InputIter2 first2, InputIter2 last2,
+                                    OutputIter result, Compared comp) {
+  while (first1 != last1 && first2 != last2) {
+    if (comp(*first1, *first2)) {
+      *result = *first1;
+      ++first1, ++result;
+    } else if (comp(*first2, *first1)) {
+      *result = *first2;
+      ++first2, ++result;
+    } else {
+      ++first1, ++first2;
+    }
+  }
+  return tiny_stl::copy(first2, last2, tiny_stl::copy(first1, last1, result));
+}
+
 template <class RandomIter> bool is_heap(RandomIter first, RandomIter last) {
   auto n = tiny_stl::distance(first, last);
   auto parent = 0;
@@ -910,9 +1830,21 @@ OutputIter remove_copy(InputIter first, InputIter last, OutputIter result,
 template <class ForwardIter, class T>
 ForwardIter remove(ForwardIter first, ForwardIter last, const T &value) {
   first = tiny_stl::find(first, last, value);
+  if (first == last)
+    return first;
+  // Move the blocks between two removed elements at once, `find` skips over
+  // each block a vector at a time on contiguous arithmetic ranges.
+  auto result = first;
   auto next = first;
-  return first == last ? first
-                       : tiny_stl::remove_copy(++next, last, first, value);
+  ++next;
+  while (next != last) {
+    auto hit = tiny_stl::find(next, last, value);
+    result = tiny_stl::move(next, hit, result);
+    if (hit == last)
+      break;
+    next = ++hit;
+  }
+  return result;
 }
 
 template <class InputIter, class OutputIter, class UnaryPredicate>
@@ -1006,27 +1938,174 @@ OutputIter reverse_copy(BidirectionalIter first, BidirectionalIter last,
   return result;
 }
 
-template <class RandomIter>
-void random_shuffle(RandomIter first, RandomIter last) {
-  if (first == last)
-    return;
-  srand((unsigned)time(0));
-  for (auto i = first + 1; i != last; ++i) {
-    tiny_stl::iter_swap(i, first + (rand() % (i - first + 1)));
+// Swap targets drawn ahead by `shuffle`, so that their cache misses overlap.
+constexpr static size_t kShuffleBatchSize = 16;
+
+// Fisher-Yates shuffle, the bounded draws take Lemire's nearly divisionless
+// path for the full-range engines. The targets do not depend on the elements,
+// so on contiguous ranges a batch of them is drawn and prefetched before
+// their swaps.
+template <class RandomIter, class URBG>
+void shuffle(RandomIter first, RandomIter last, URBG &&g) {
+  using Distance = decltype(last - first);
+  const Distance n = last - first;
+  Distance i = 1;
+  if constexpr (tiny_stl::is_contiguous_iterator_v<RandomIter>) {
+    constexpr auto batch = static_cast<Distance>(kShuffleBatchSize);
+    const auto *data = tiny_stl::to_address(first);
+    Distance targets[kShuffleBatchSize];
+    for (; i + batch <= n; i += batch) {
+      for (Distance k = 0; k < batch; ++k) {
+        const auto range = static_cast<std::uint64_t>(i + k) + 1;
+        targets[k] =
+            static_cast<Distance>(tiny_stl::uniform_bounded(g, range));
+        __builtin_prefetch(data + targets[k]);
+      }
+      for (Distance k = 0; k < batch; ++k)
+        tiny_stl::iter_swap(first + (i + k), first + targets[k]);
+    }
+  }
+  for (; i < n; ++i) {
+    const auto range = static_cast<std::uint64_t>(i) + 1;
+    const auto j = tiny_stl::uniform_bounded(g, range);
+    tiny_stl::iter_swap(first + i, first + static_cast<Distance>(j));
   }
 }
 
+template <class RandomIter>
+void random_shuffle(RandomIter first, RandomIter last) {
+  tiny_stl::shuffle(first, last, tiny_stl::thread_random_engine());
+}
+
+// `rand(n)` returns a uniform integer in [0, n).
 template <class RandomIter, class RandomNumberGenerator>
 void random_shuffle(RandomIter first, RandomIter last,
                     RandomNumberGenerator &rand) {
   if (first == last)
     return;
-  auto len = tiny_stl::distance(first, last);
   for (auto i = first + 1; i != last; ++i) {
-    tiny_stl::iter_swap(i, first + (rand(i - first + 1) % len));
+    tiny_stl::iter_swap(i, first + rand(i - first + 1));
   }
 }
 
+// Selection sampling: the length is known, so every element is kept with the
+// probability that the remaining picks need it, and the sample keeps the order
+// of the range.
+template <class ForwardIter, class OutputIter, class Distance, class URBG>
+OutputIter sample_dispatch(ForwardIter first, ForwardIter last, OutputIter out,
+                           Distance k, forward_iterator_tag, URBG &g) {
+  auto remaining = static_cast<std::uint64_t>(tiny_stl::distance(first, last));
+  auto needed = static_cast<std::uint64_t>(k > 0 ? k : 0);
+  needed = needed < remaining ? needed : remaining;
+  for (; needed > 0; ++first, --remaining) {
+    if (tiny_stl::uniform_bounded(g, remaining) < needed) {
+      *out = *first;
+      ++out;
+      --needed;
+    }
+  }
+  return out;
+}
+
+// Reservoir sampling by Li's Algorithm L: the weight `w` is the largest of k
+// uniform keys kept so far, the number of elements to skip before the next
+// one enters the reservoir is geometric in `w`, so only `O(k log(n / k))`
+// numbers are drawn. The sample is not in the order of the range.
+template <class InputIter, class RandomIter, class Distance, class URBG>
+RandomIter sample_dispatch(InputIter first, InputIter last, RandomIter out,
+                           Distance k, input_iterator_tag, URBG &g) {
+  if (k <= 0)
+    return out;
+  Distance count = 0;
+  for (; first != last && count < k; ++first, ++count)
+    out[count] = *first;
+  if (count < k)
+    return out + count;
+  const double inv_k = 1.0 / static_cast<double>(k);
+  double w = std::exp(std::log(tiny_stl::uniform_unit(g)) * inv_k);
+  while (true) {
+    double skip =
+        std::floor(std::log(tiny_stl::uniform_unit(g)) / std::log1p(-w));
+    for (; skip >= 1 && first != last; skip -= 1)
+      ++first;
+    if (first == last)
+      break;
+    const auto slot =
+        tiny_stl::uniform_bounded(g, static_cast<std::uint64_t>(k));
+    out[static_cast<Distance>(slot)] = *first;
+    ++first;
+    w *= std::exp(std::log(tiny_stl::uniform_unit(g)) * inv_k);
+  }
+  return out + k;
+}
+
+// Copy `k` elements picked uniformly at random from [first, last) to `out`,
+// or all of them if there are fewer. Forward ranges keep their order, single
+// pass input ranges are sampled into a reservoir, which needs a random access
+// `out`.
+template <class InputIter, class OutputIter, class Distance, class URBG>
+OutputIter sample(InputIter first, InputIter last, OutputIter out, Distance k,
+                  URBG &&g) {
+  return tiny_stl::sample_dispatch(first, last, out, k,
+                                   iterator_category(first), g);
+}
+
+// Copy `k` elements picked at random from [first, last) with probabilities
+// proportional to `weight_of(element)` to `out`, in no particular order, by
+// Efraimidis and Spirakis' A-ExpJ: every element draws the key `u^(1/w)`, the
+// `k` largest keys are kept in a heap, and the total weight to skip before the
+// next key beats the smallest kept one is drawn at once. The elements of weight
+// zero or less are never picked. Returns the end of the sample, which is short
+// when fewer than `k` elements have a positive weight.
+template <class InputIter, class RandomIter, class Distance, class WeightOf,
+          class URBG>
+RandomIter weighted_sample(InputIter first, InputIter last, RandomIter out,
+                           Distance k, WeightOf weight_of, URBG &&g) {
+  struct entry {
+    double log_key; // The logarithm of the key, which keeps tiny keys apart.
+    Distance slot;
+  };
+  auto greater = [](const entry &x, const entry &y) {
+    return x.log_key > y.log_key;
+  };
+  if (k <= 0)
+    return out;
+  tiny_stl::vector<entry> heap;
+  Distance count = 0;
+  for (; first != last && count < k; ++first) {
+    const double weight = static_cast<double>(weight_of(*first));
+    if (!(weight > 0))
+      continue;
+    out[count] = *first;
+    heap.push_back({std::log(tiny_stl::uniform_unit(g)) / weight, count});
+    ++count;
+  }
+  if (count < k)
+    return out + count;
+  entry *heap_first = heap.data();
+  entry *heap_last = heap_first + heap.size();
+  tiny_stl::make_heap(heap_first, heap_last, greater);
+
+  double skip = std::log(tiny_stl::uniform_unit(g)) / heap_first->log_key;
+  for (; first != last; ++first) {
+    const double weight = static_cast<double>(weight_of(*first));
+    if (!(weight > 0))
+      continue;
+    skip -= weight;
+    if (skip > 0)
+      continue;
+    // The key is uniform among those beating the smallest kept one.
+    const double threshold = std::exp(heap_first->log_key * weight);
+    const double u = threshold + (1 - threshold) * tiny_stl::uniform_unit(g);
+    tiny_stl::pop_heap(heap_first, heap_last, greater);
+    heap_last[-1].log_key = std::log(u) / weight;
+    out[heap_last[-1].slot] = *first;
+    tiny_stl::push_heap(heap_first, heap_last, greater);
+    skip = std::log(tiny_stl::uniform_unit(g)) / heap_first->log_key;
+  }
+  return out + k;
+}
+
 template <class ForwardIter>
 ForwardIter rotate_dispatch(ForwardIter first, ForwardIter middle,
                             ForwardIter last, forward_iterator_tag) {
@@ -1133,6 +2212,96 @@ ForwardIter rotate_copy(ForwardIter first, ForwardIter middle, ForwardIter last,
   return tiny_stl::copy(first, middle, tiny_stl::copy(middle, last, result));
 }
 
+// Ranges shorter than this are compared by counting every element in both,
+// longer ones by a hash table or by sorting when `==` is the predicate.
+constexpr static size_t kIsPermutationQuadraticSize = 32;
+// Ranges of integers or pointers at least this long are sorted rather than
+// counted in a hash table: both run at about the speed of the memory by then,
+// and the copies take less of it than the table of iterators and counts.
+constexpr static size_t kIsPermutationSortSize = 1 << 24;
+
+template <class T, class = void> struct is_hashable : tiny_stl::false_type {};
+
+template <class T>
+struct is_hashable<T, std::void_t<decltype(std::declval<tiny_stl::hash<T> &>()(
+                          std::declval<const T &>()))>>
+    : tiny_stl::true_type {};
+
+// The types whose `==` is the equivalence of a cheap `<`, so that two
+// sorted copies can be compared element by element.
+template <class T>
+inline constexpr bool is_cheaply_sortable_v =
+    std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// Count the elements of the first range in an open-addressing table of
+// iterators, then take the second range off the counts.
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_hashed(ForwardIter1 first1, ForwardIter1 last1,
+                           ForwardIter2 first2, size_t n) {
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(*first1)>>;
+  // `count` is one more than the count, so 0 marks the empty slots.
+  struct slot {
+    ForwardIter1 key{};
+    size_t count = 0;
+  };
+  unsigned bits = 1;
+  while ((size_t(1) << bits) < 2 * n)
+    ++bits;
+  const size_t mask = (size_t(1) << bits) - 1;
+  std::unique_ptr<slot[]> table(new slot[mask + 1]);
+  tiny_stl::hash<T> hasher;
+  // The trivial hashes of the integers need their high bits spread.
+  auto home = [&](const T &value) {
+    const auto h = static_cast<std::uint64_t>(hasher(value));
+    return static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+  };
+  for (; first1 != last1; ++first1) {
+    size_t i = home(*first1);
+    while (table[i].count != 0 && !(*table[i].key == *first1))
+      i = (i + 1) & mask;
+    if (table[i].count == 0) {
+      table[i].key = first1;
+      table[i].count = 1;
+    }
+    ++table[i].count;
+  }
+  for (; n > 0; --n, ++first2) {
+    size_t i = home(*first2);
+    while (table[i].count != 0 && !(*table[i].key == *first2))
+      i = (i + 1) & mask;
+    if (table[i].count <= 1)
+      return false;
+    --table[i].count;
+  }
+  return true;
+}
+
+template <class RandomIter> void sort(RandomIter first, RandomIter last);
+
+// Sort copies of both ranges and compare them, false when the copies do not
+// fit in memory.
+template <class ForwardIter1, class ForwardIter2>
+bool is_permutation_sorted(ForwardIter1 first1, ForwardIter1 last1,
+                           ForwardIter2 first2, ForwardIter2 last2, size_t n,
+                           bool &result) {
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(*first1)>>;
+  temporary_buffer<ForwardIter1, T> buf1(first1, last1);
+  temporary_buffer<ForwardIter2, T> buf2(first2, last2);
+  if (static_cast<size_t>(buf1.size()) < n ||
+      static_cast<size_t>(buf2.size()) < n)
+    return false;
+  T *const a = buf1.begin();
+  T *const b = buf2.begin();
+  for (size_t i = 0; i < n; ++i, ++first1, ++first2) {
+    a[i] = *first1;
+    b[i] = *first2;
+  }
+  tiny_stl::sort(a, a + n);
+  tiny_stl::sort(b, b + n);
+  result = tiny_stl::equal(a, a + n, b);
+  return true;
+}
+
 template <class ForwardIter1, class ForwardIter2, class BinaryPred>
 bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1,
                         ForwardIter2 first2, ForwardIter2 last2,
@@ -1162,6 +2331,23 @@ bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1,
       return false;
   }
 
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(*first1)>>;
+  if constexpr (std::is_same_v<BinaryPred, tiny_stl::equal_to<T>>) {
+    const auto n = static_cast<size_t>(tiny_stl::distance(first1, last1));
+    if (n >= kIsPermutationQuadraticSize) {
+      bool result = false;
+      if constexpr (tiny_stl::is_cheaply_sortable_v<T>) {
+        if ((!tiny_stl::is_hashable<T>::value ||
+             n >= kIsPermutationSortSize) &&
+            tiny_stl::is_permutation_sorted(first1, last1, first2, last2, n,
+                                            result))
+          return result;
+      }
+      if constexpr (tiny_stl::is_hashable<T>::value)
+        return tiny_stl::is_permutation_hashed(first1, last1, first2, n);
+    }
+  }
+
   for (auto i = first1; i != last1; ++i) {
     bool is_repeated = false;
     for (auto j = first1; j != i; ++j) {
@@ -1332,6 +2518,29 @@ OutputIter merge(InputIter1 first1, InputIter1 last1, InputIter2 first2,
   return tiny_stl::copy(first2, last2, tiny_stl::copy(first1, last1, result));
 }
 
+// Merge the sorted ranges of `[ranges_first, ranges_last)`, each a pair of
+// iterators, through a loser tree: `log(K)` comparisons an element for `K`
+// ranges, in one pass. Equal elements keep the order of their ranges.
+template <class RangeIter, class OutputIter, class Compared>
+OutputIter multiway_merge(RangeIter ranges_first, RangeIter ranges_last,
+                          OutputIter result, Compared comp) {
+  using Iter = std::decay_t<decltype((*ranges_first).first)>;
+  tiny_stl::loser_tree<Iter, Compared> tree(ranges_first, ranges_last, comp);
+  for (; !tree.empty(); tree.pop()) {
+    *result = tree.top();
+    ++result;
+  }
+  return result;
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter multiway_merge(RangeIter ranges_first, RangeIter ranges_last,
+                          OutputIter result) {
+  return tiny_stl::multiway_merge(
+      ranges_first, ranges_last, result,
+      [](const auto &x, const auto &y) { return x < y; });
+}
+
 template <class BidirectionalIter, class Distance>
 void merge_without_buffer(BidirectionalIter first, BidirectionalIter middle,
                           BidirectionalIter last, Distance len1,
@@ -1590,7 +2799,8 @@ void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
   tiny_stl::make_heap(first, middle);
   for (auto i = middle; i < last; ++i) {
     if (*i < *first) {
-      tiny_stl::pop_heap_aux(first, middle, i, *i, distance_type(first));
+      tiny_stl::pop_heap_aux(first, middle, i, tiny_stl::move(*i),
+                             distance_type(first));
     }
   }
   tiny_stl::sort_heap(first, middle);
@@ -1602,7 +2812,8 @@ void partial_sort(RandomIter first, RandomIter middle, RandomIter last,
   tiny_stl::make_heap(first, middle, comp);
   for (auto i = middle; i < last; ++i) {
     if (comp(*i, *first)) {
-      tiny_stl::pop_heap_aux(first, middle, i, *i, distance_type(first), comp);
+      tiny_stl::pop_heap_aux(first, middle, i, tiny_stl::move(*i),
+                             distance_type(first), comp);
     }
   }
   tiny_stl::sort_heap(first, middle, comp);
@@ -1707,7 +2918,15 @@ partition_copy(InputIter first, InputIter last, OutputIter1 result_true,
   return tiny_stl::pair<OutputIter1, OutputIter2>(result_true, result_false);
 }
 
-constexpr static size_t kSmallSectionSize = 128;
+// Ranges shorter than this are sorted by insertion sort in `sort`.
+constexpr static size_t kPdqInsertionSortSize = 24;
+// Ranges longer than this take the pivot as the ninther of nine elements.
+constexpr static size_t kPdqNintherSize = 128;
+// How many elements a partial insertion sort may move before giving up.
+constexpr static size_t kPdqPartialInsertionLimit = 8;
+// The number of elements classified at once by the branchless partition.
+constexpr static size_t kPdqBlockSize = 64;
+constexpr static size_t kPdqCachelineSize = 64;
 
 template <class Size> Size slg2(Size n) {
   Size k = 0;
@@ -1732,22 +2951,6 @@ RandomIter unchecked_partition(RandomIter first, RandomIter last,
   }
 }
 
-template <class RandomIter, class Size>
-void intro_sort(RandomIter first, RandomIter last, Size depth_limit) {
-  while (static_cast<size_t>(last - first) > kSmallSectionSize) {
-    if (depth_limit == 0) {
-      tiny_stl::partial_sort(first, last, last);
-      return;
-    }
-    --depth_limit;
-    auto mid =
-        tiny_stl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-    auto cut = tiny_stl::unchecked_partition(first, last, mid);
-    tiny_stl::intro_sort(cut, last, depth_limit);
-    last = cut;
-  }
-}
-
 template <class RandomIter, class T>
 void unchecked_linear_insert(RandomIter last, const T &value) {
   auto next = last;
@@ -1760,13 +2963,6 @@ void unchecked_linear_insert(RandomIter last, const T &value) {
   *last = value;
 }
 
-template <class RandomIter>
-void unchecked_insertion_sort(RandomIter first, RandomIter last) {
-  for (auto i = first; i != last; ++i) {
-    tiny_stl::unchecked_linear_insert(i, *i);
-  }
-}
-
 template <class RandomIter>
 void insertion_sort(RandomIter first, RandomIter last) {
   if (first == last)
@@ -1782,23 +2978,6 @@ void insertion_sort(RandomIter first, RandomIter last) {
   }
 }
 
-template <class RandomIter>
-void final_insertion_sort(RandomIter first, RandomIter last) {
-  if (static_cast<size_t>(last - first) > kSmallSectionSize) {
-    tiny_stl::insertion_sort(first, first + kSmallSectionSize);
-    tiny_stl::unchecked_insertion_sort(first + kSmallSectionSize, last);
-  } else {
-    tiny_stl::insertion_sort(first, last);
-  }
-}
-
-template <class RandomIter> void sort(RandomIter first, RandomIter last) {
-  if (first != last) {
-    tiny_stl::intro_sort(first, last, slg2(last - first) * 2);
-    tiny_stl::final_insertion_sort(first, last);
-  }
-}
-
 template <class RandomIter, class T, class Compared>
 RandomIter unchecked_partition(RandomIter first, RandomIter last,
                                const T &pivot, Compared comp) {
@@ -1815,23 +2994,6 @@ RandomIter unchecked_partition(RandomIter first, RandomIter last,
   }
 }
 
-template <class RandomIter, class Size, class Compared>
-void intro_sort(RandomIter first, RandomIter last, Size depth_limit,
-                Compared comp) {
-  while (static_cast<size_t>(last - first) > kSmallSectionSize) {
-    if (depth_limit == 0) {
-      tiny_stl::partial_sort(first, last, last, comp);
-      return;
-    }
-    --depth_limit;
-    auto mid =
-        tiny_stl::median(*(first), *(first + (last - first) / 2), *(last - 1));
-    auto cut = tiny_stl::unchecked_partition(first, last, mid, comp);
-    tiny_stl::intro_sort(cut, last, depth_limit, comp);
-    last = cut;
-  }
-}
-
 template <class RandomIter, class T, class Compared>
 void unchecked_linear_insert(RandomIter last, const T &value, Compared comp) {
   auto next = last;
@@ -1844,14 +3006,6 @@ void unchecked_linear_insert(RandomIter last, const T &value, Compared comp) {
   *last = value;
 }
 
-template <class RandomIter, class Compared>
-void unchecked_insertion_sort(RandomIter first, RandomIter last,
-                              Compared comp) {
-  for (auto i = first; i != last; ++i) {
-    tiny_stl::unchecked_linear_insert(i, *i, comp);
-  }
-}
-
 template <class RandomIter, class Compared>
 void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
   if (first == last)
@@ -1867,56 +3021,1820 @@ void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
   }
 }
 
+// The comparators for which a comparison of arithmetic values compiles to a
+// flag, so the block partition can turn it into an index without a branch.
+template <class T, class Compared>
+struct is_branchless_comparable
+    : std::bool_constant<
+          (std::is_arithmetic_v<T> || std::is_pointer_v<T>) &&
+          (std::is_same_v<Compared, tiny_stl::less<T>> ||
+           std::is_same_v<Compared, tiny_stl::greater<T>> ||
+           std::is_same_v<Compared, std::less<T>> ||
+           std::is_same_v<Compared, std::greater<T>> ||
+           std::is_same_v<Compared, std::less<>> ||
+           std::is_same_v<Compared, std::greater<>>)> {};
+
+// Ranges up to this long are sorted by a fixed sorting network when the
+// comparison is branch free.
+constexpr static size_t kSortNetworkMaxSize = 32;
+// Ranges of 32-bit integers from this long up to `kSimdSortMaxSize` are
+// sorted in vector registers instead, when sorted by `<`.
+constexpr static size_t kSimdSortMinSize = 16;
+constexpr static size_t kSimdSortMaxSize = 64;
+
+// A comparator of a sorting network, between the positions `lo` and `hi`.
+struct sort_network_pair {
+  std::uint8_t lo;
+  std::uint8_t hi;
+};
+
+// Batcher's odd-even merge sort over the next power of two, calling `visit`
+// with every comparator which touches no position from `n` on: those would
+// hold values above all the others, which the comparators never move.
+template <class Visit>
+constexpr void sort_network_visit(size_t n, Visit &visit) {
+  size_t p2 = 1;
+  while (p2 < n)
+    p2 *= 2;
+  for (size_t p = 1; p < p2; p *= 2) {
+    for (size_t k = p; k >= 1; k /= 2) {
+      for (size_t j = k % p; j + k < p2; j += 2 * k) {
+        for (size_t i = 0; i < k && i + j + k < n; ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+            visit(i + j, i + j + k);
+        }
+      }
+    }
+  }
+}
+
+constexpr size_t sort_network_size(size_t n) {
+  size_t count = 0;
+  auto visit = [&count](size_t, size_t) { ++count; };
+  tiny_stl::sort_network_visit(n, visit);
+  return count;
+}
+
+template <size_t N> struct sort_network {
+  sort_network_pair pairs[sort_network_size(N)];
+};
+
+template <size_t N> constexpr sort_network<N> make_sort_network() {
+  sort_network<N> network{};
+  size_t count = 0;
+  auto visit = [&](size_t lo, size_t hi) {
+    network.pairs[count].lo = static_cast<std::uint8_t>(lo);
+    network.pairs[count].hi = static_cast<std::uint8_t>(hi);
+    ++count;
+  };
+  tiny_stl::sort_network_visit(N, visit);
+  return network;
+}
+
+template <size_t N>
+inline constexpr sort_network<N> sort_network_v = make_sort_network<N>();
+
+#if defined(__SSE2__)
+template <class T, class Compared>
+inline constexpr bool is_descending_comparator_v =
+    std::is_same_v<Compared, tiny_stl::greater<T>> ||
+    std::is_same_v<Compared, std::greater<T>> ||
+    std::is_same_v<Compared, std::greater<>>;
+
+// The smaller and the larger of `x` and `y`, the ties keeping their order.
+// `minsd(a, b)` is `a < b ? a : b` and `maxsd(a, b)` is `a > b ? a : b`.
+template <bool Descending>
+void sort_network_exchange_sd(double &x, double &y) {
+  const __m128d a = _mm_set_sd(x);
+  const __m128d b = _mm_set_sd(y);
+  x = _mm_cvtsd_f64(Descending ? _mm_max_sd(b, a) : _mm_min_sd(b, a));
+  y = _mm_cvtsd_f64(Descending ? _mm_min_sd(a, b) : _mm_max_sd(a, b));
+}
+
+template <bool Descending> void sort_network_exchange_ss(float &x, float &y) {
+  const __m128 a = _mm_set_ss(x);
+  const __m128 b = _mm_set_ss(y);
+  x = _mm_cvtss_f32(Descending ? _mm_max_ss(b, a) : _mm_min_ss(b, a));
+  y = _mm_cvtss_f32(Descending ? _mm_min_ss(a, b) : _mm_max_ss(a, b));
+}
+#endif
+
+template <class T, class Compared>
+void sort_network_exchange(T &a, T &b, Compared &comp) {
+#if defined(__SSE2__)
+  // Compilers tend to branch on a floating point comparison selecting two
+  // values, the min and max instructions do not.
+  if constexpr (std::is_same_v<T, double>) {
+    tiny_stl::sort_network_exchange_sd<
+        is_descending_comparator_v<T, Compared>>(a, b);
+    return;
+  } else if constexpr (std::is_same_v<T, float>) {
+    tiny_stl::sort_network_exchange_ss<
+        is_descending_comparator_v<T, Compared>>(a, b);
+    return;
+  }
+#endif
+  const T x = a;
+  const T y = b;
+  const bool swap = comp(y, x);
+  a = swap ? y : x;
+  b = swap ? x : y;
+}
+
+// Sort `N` elements by the network, unrolled on a copy which the compiler
+// keeps in registers. Not stable.
+template <size_t N, class RandomIter, class Compared, size_t... Is>
+void sort_network_sort(RandomIter first, Compared &comp,
+                       std::index_sequence<Is...>) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  constexpr const sort_network<N> &network = sort_network_v<N>;
+  T v[N];
+  for (size_t i = 0; i < N; ++i)
+    v[i] = first[i];
+  (tiny_stl::sort_network_exchange(v[network.pairs[Is].lo],
+                                   v[network.pairs[Is].hi], comp),
+   ...);
+  for (size_t i = 0; i < N; ++i)
+    first[i] = v[i];
+}
+
+template <size_t N, class RandomIter, class Compared>
+void sort_network_sort(RandomIter first, Compared &comp) {
+  tiny_stl::sort_network_sort<N>(
+      first, comp, std::make_index_sequence<sort_network_size(N)>());
+}
+
+// Sort 2 to `kSortNetworkMaxSize` elements by the network of their number.
+template <class RandomIter, class Compared, size_t... Ns>
+void sort_network_dispatch(RandomIter first, size_t n, Compared &comp,
+                           std::index_sequence<Ns...>) {
+  using sorter = void (*)(RandomIter, Compared &);
+  static constexpr sorter sorters[] = {
+      &tiny_stl::sort_network_sort<Ns + 2, RandomIter, Compared>...};
+  sorters[n - 2](first, comp);
+}
+
+#if defined(__AVX2__)
+template <class T> __m256i simd_sort_min(__m256i a, __m256i b) {
+  if constexpr (std::is_signed_v<T>)
+    return _mm256_min_epi32(a, b);
+  else
+    return _mm256_min_epu32(a, b);
+}
+
+template <class T> __m256i simd_sort_max(__m256i a, __m256i b) {
+  if constexpr (std::is_signed_v<T>)
+    return _mm256_max_epi32(a, b);
+  else
+    return _mm256_max_epu32(a, b);
+}
+
+// One layer of a sorting network across the 8 lanes: every lane meets the
+// lane named in `partner`, and keeps the larger value where `upper` is set.
+template <class T>
+__m256i simd_sort_layer(__m256i v, __m256i partner, __m256i upper) {
+  const __m256i other = _mm256_permutevar8x32_epi32(v, partner);
+  return _mm256_blendv_epi8(tiny_stl::simd_sort_min<T>(v, other),
+                            tiny_stl::simd_sort_max<T>(v, other), upper);
+}
+
+// Sort the lanes of a bitonic vector: the half-cleaners at distance 4, 2, 1.
+template <class T> __m256i simd_sort_bitonic8(__m256i v) {
+  const __m256i high = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3), high);
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5),
+      _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1));
+  return tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6),
+      _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1));
+}
+
+// Sort the lanes of a vector by the optimal network of 19 comparators in 6
+// layers.
+template <class T> __m256i simd_sort8(__m256i v) {
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5),
+      _mm256_setr_epi32(0, 0, -1, -1, 0, 0, -1, -1));
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3),
+      _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1));
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6),
+      _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1));
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7),
+      _mm256_setr_epi32(0, 0, 0, 0, -1, -1, 0, 0));
+  v = tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(0, 4, 2, 6, 1, 5, 3, 7),
+      _mm256_setr_epi32(0, 0, 0, 0, -1, 0, -1, 0));
+  return tiny_stl::simd_sort_layer<T>(
+      v, _mm256_setr_epi32(0, 2, 1, 4, 3, 6, 5, 7),
+      _mm256_setr_epi32(0, 0, -1, 0, -1, 0, -1, 0));
+}
+
+// Merge the sorted runs `r[0, W)` and `r[W, 2W)` of vectors: the second run
+// is reversed, which makes the whole bitonic, and then sorted by bitonic
+// half-cleaners across the vectors and inside them.
+template <class T, size_t W> void simd_sort_merge(__m256i *r) {
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  for (size_t i = 0; i < W / 2; ++i) {
+    const __m256i t = r[W + i];
+    r[W + i] = r[2 * W - 1 - i];
+    r[2 * W - 1 - i] = t;
+  }
+  for (size_t i = W; i < 2 * W; ++i)
+    r[i] = _mm256_permutevar8x32_epi32(r[i], reverse);
+  for (size_t d = W; d >= 1; d /= 2) {
+    for (size_t i = 0; i < 2 * W; ++i) {
+      if ((i & d) == 0) {
+        const __m256i lo = tiny_stl::simd_sort_min<T>(r[i], r[i + d]);
+        r[i + d] = tiny_stl::simd_sort_max<T>(r[i], r[i + d]);
+        r[i] = lo;
+      }
+    }
+  }
+  for (size_t i = 0; i < 2 * W; ++i)
+    r[i] = tiny_stl::simd_sort_bitonic8<T>(r[i]);
+}
+
+// Sort `R` vectors of 8 keys: each vector on its own, then the runs merged
+// two by two.
+template <class T, size_t R> void simd_sort_vectors(__m256i *r) {
+  for (size_t i = 0; i < R; ++i)
+    r[i] = tiny_stl::simd_sort8<T>(r[i]);
+  if constexpr (R >= 2) {
+    for (size_t i = 0; i < R; i += 2)
+      tiny_stl::simd_sort_merge<T, 1>(r + i);
+  }
+  if constexpr (R >= 4) {
+    for (size_t i = 0; i < R; i += 4)
+      tiny_stl::simd_sort_merge<T, 2>(r + i);
+  }
+  if constexpr (R >= 8)
+    tiny_stl::simd_sort_merge<T, 4>(r);
+}
+
+// Sort `kSimdSortMinSize` to `kSimdSortMaxSize` 32-bit integers, padded to
+// 16, 32 or 64 with the largest value.
+template <class T> void simd_small_sort(T *data, size_t n) {
+  alignas(32) T keys[kSimdSortMaxSize];
+  const size_t vectors = n <= 16 ? 2 : n <= 32 ? 4 : 8;
+  for (size_t i = 0; i < n; ++i)
+    keys[i] = data[i];
+  for (size_t i = n; i < vectors * 8; ++i)
+    keys[i] = std::numeric_limits<T>::max();
+  __m256i r[8];
+  for (size_t i = 0; i < vectors; ++i)
+    r[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys) + i);
+  if (vectors == 2)
+    tiny_stl::simd_sort_vectors<T, 2>(r);
+  else if (vectors == 4)
+    tiny_stl::simd_sort_vectors<T, 4>(r);
+  else
+    tiny_stl::simd_sort_vectors<T, 8>(r);
+  for (size_t i = 0; i < vectors; ++i)
+    _mm256_store_si256(reinterpret_cast<__m256i *>(keys) + i, r[i]);
+  for (size_t i = 0; i < n; ++i)
+    data[i] = keys[i];
+}
+#endif
+
+// Whether the short ranges of `T` sorted by `Compared` are sorted by a
+// network, which needs a branch free comparison, and whether by vector
+// registers, which needs 32-bit integers in ascending order.
+template <class T, class Compared>
+inline constexpr bool is_network_sortable_v =
+    is_branchless_comparable<T, Compared>::value;
+
+template <class T, class Compared>
+inline constexpr bool is_simd_small_sortable_v =
+#if defined(__AVX2__)
+    std::is_integral_v<T> && sizeof(T) == 4 &&
+    (std::is_same_v<Compared, tiny_stl::less<T>> ||
+     std::is_same_v<Compared, std::less<T>> ||
+     std::is_same_v<Compared, std::less<>>);
+#else
+    false;
+#endif
+
+// The longest range `small_sort` sorts, 0 if it sorts none.
+template <class RandomIter, class Compared>
+constexpr size_t small_sort_size() {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  if constexpr (is_simd_small_sortable_v<T, Compared> &&
+                tiny_stl::is_contiguous_iterator_v<RandomIter>)
+    return kSimdSortMaxSize;
+  else if constexpr (is_network_sortable_v<T, Compared>)
+    return kSortNetworkMaxSize;
+  else
+    return 0;
+}
+
+// Sort a range of at most `small_sort_size()` elements without data
+// dependent branches.
+template <class RandomIter, class Compared>
+void small_sort(RandomIter first, RandomIter last, Compared &comp) {
+  static_assert(small_sort_size<RandomIter, Compared>() > 0,
+                "small_sort needs a branch free comparison");
+  const auto n = static_cast<size_t>(last - first);
+#if defined(__AVX2__)
+  if constexpr (small_sort_size<RandomIter, Compared>() == kSimdSortMaxSize) {
+    if (n >= kSimdSortMinSize) {
+      tiny_stl::simd_small_sort(tiny_stl::to_address(first), n);
+      return;
+    }
+  }
+#endif
+  if (n >= 2) {
+    tiny_stl::sort_network_dispatch(
+        first, n, comp, std::make_index_sequence<kSortNetworkMaxSize - 1>());
+  }
+}
+
+// Insertion sort moving the elements, `unguarded` requires an element before
+// `first` which is not greater than any element of the range.
+template <bool Unguarded, class RandomIter, class Compared>
+void pdq_insertion_sort(RandomIter first, RandomIter last, Compared &comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  if (first == last)
+    return;
+  for (auto cur = first + 1; cur != last; ++cur) {
+    auto sift = cur;
+    auto sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      T tmp = tiny_stl::move(*sift);
+      do {
+        *sift-- = tiny_stl::move(*sift_1);
+      } while ((Unguarded || sift != first) && comp(tmp, *--sift_1));
+      *sift = tiny_stl::move(tmp);
+    }
+  }
+}
+
+// Insertion sort which gives up once it has moved too many elements, the
+// return value tells whether the range has been sorted.
+template <class RandomIter, class Compared>
+bool pdq_partial_insertion_sort(RandomIter first, RandomIter last,
+                                Compared &comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  if (first == last)
+    return true;
+  size_t limit = 0;
+  for (auto cur = first + 1; cur != last; ++cur) {
+    auto sift = cur;
+    auto sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      T tmp = tiny_stl::move(*sift);
+      do {
+        *sift-- = tiny_stl::move(*sift_1);
+      } while (sift != first && comp(tmp, *--sift_1));
+      *sift = tiny_stl::move(tmp);
+      limit += static_cast<size_t>(cur - sift);
+    }
+    if (limit > kPdqPartialInsertionLimit)
+      return cur + 1 == last;
+  }
+  return true;
+}
+
+template <class RandomIter, class Compared>
+void pdq_sort2(RandomIter a, RandomIter b, Compared &comp) {
+  if (comp(*b, *a))
+    tiny_stl::iter_swap(a, b);
+}
+
+template <class RandomIter, class Compared>
+void pdq_sort3(RandomIter a, RandomIter b, RandomIter c, Compared &comp) {
+  tiny_stl::pdq_sort2(a, b, comp);
+  tiny_stl::pdq_sort2(b, c, comp);
+  tiny_stl::pdq_sort2(a, b, comp);
+}
+
+template <class T> T *pdq_align_cacheline(T *ptr) {
+  const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+  const auto aligned =
+      (address + kPdqCachelineSize - 1) & ~(kPdqCachelineSize - 1);
+  return reinterpret_cast<T *>(aligned);
+}
+
+// Swap the misplaced elements found by the block partition. When the two
+// sides have different counts a cyclic permutation is cheaper than swaps.
+template <class RandomIter>
+void pdq_swap_offsets(RandomIter first, RandomIter last,
+                      const unsigned char *offsets_l,
+                      const unsigned char *offsets_r, size_t num,
+                      bool use_swaps) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  if (use_swaps) {
+    for (size_t i = 0; i < num; ++i) {
+      tiny_stl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+    }
+  } else if (num > 0) {
+    auto l = first + offsets_l[0];
+    auto r = last - offsets_r[0];
+    T tmp = tiny_stl::move(*l);
+    *l = tiny_stl::move(*r);
+    for (size_t i = 1; i < num; ++i) {
+      l = first + offsets_l[i];
+      *r = tiny_stl::move(*l);
+      r = last - offsets_r[i];
+      *l = tiny_stl::move(*r);
+    }
+    *r = tiny_stl::move(tmp);
+  }
+}
+
+// Partition around the pivot at `first`, the elements equal to the pivot go
+// to the right. Returns the final position of the pivot and whether the range
+// was already partitioned. With `Branchless`, the elements are classified
+// block by block into offset buffers, and only the misplaced ones are swapped.
+template <bool Branchless, class RandomIter, class Compared>
+tiny_stl::pair<RandomIter, bool>
+pdq_partition_right(RandomIter first, RandomIter last, Compared &comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto begin = first;
+  T pivot = tiny_stl::move(*first);
+
+  // The median-of-three guarantees the scans stop inside the range.
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+  const bool already_partitioned = first >= last;
+
+  if constexpr (Branchless) {
+    if (!already_partitioned) {
+      tiny_stl::iter_swap(first, last);
+      ++first;
+
+      unsigned char offsets_l_storage[kPdqBlockSize + kPdqCachelineSize];
+      unsigned char offsets_r_storage[kPdqBlockSize + kPdqCachelineSize];
+      unsigned char *offsets_l = tiny_stl::pdq_align_cacheline(
+          static_cast<unsigned char *>(offsets_l_storage));
+      unsigned char *offsets_r = tiny_stl::pdq_align_cacheline(
+          static_cast<unsigned char *>(offsets_r_storage));
+      auto offsets_l_base = first;
+      auto offsets_r_base = last;
+      size_t num_l = 0;
+      size_t num_r = 0;
+      size_t start_l = 0;
+      size_t start_r = 0;
+      while (first < last) {
+        // Fill the empty offset buffers, splitting the rest in two when both
+        // are empty.
+        const auto num_unknown = static_cast<size_t>(last - first);
+        const size_t left_split =
+            num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+        const size_t right_split = num_r == 0 ? num_unknown - left_split : 0;
+        const size_t left_count =
+            left_split < kPdqBlockSize ? left_split : kPdqBlockSize;
+        const size_t right_count =
+            right_split < kPdqBlockSize ? right_split : kPdqBlockSize;
+        for (size_t i = 0; i < left_count; ++i) {
+          offsets_l[num_l] = static_cast<unsigned char>(i);
+          num_l += !comp(*first, pivot);
+          ++first;
+        }
+        for (size_t i = 0; i < right_count;) {
+          offsets_r[num_r] = static_cast<unsigned char>(++i);
+          num_r += comp(*--last, pivot);
+        }
+
+        const size_t num = num_l < num_r ? num_l : num_r;
+        tiny_stl::pdq_swap_offsets(offsets_l_base, offsets_r_base,
+                                   offsets_l + start_l, offsets_r + start_r,
+                                   num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+          start_l = 0;
+          offsets_l_base = first;
+        }
+        if (num_r == 0) {
+          start_r = 0;
+          offsets_r_base = last;
+        }
+      }
+
+      // At most one buffer still holds misplaced elements.
+      if (num_l) {
+        offsets_l += start_l;
+        while (num_l--) {
+          tiny_stl::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+        }
+        first = last;
+      }
+      if (num_r) {
+        offsets_r += start_r;
+        while (num_r--) {
+          tiny_stl::iter_swap(offsets_r_base - offsets_r[num_r], first);
+          ++first;
+        }
+        last = first;
+      }
+    }
+  } else {
+    while (first < last) {
+      tiny_stl::iter_swap(first, last);
+      while (comp(*++first, pivot)) {
+      }
+      while (!comp(*--last, pivot)) {
+      }
+    }
+  }
+
+  const auto pivot_pos = first - 1;
+  *begin = tiny_stl::move(*pivot_pos);
+  *pivot_pos = tiny_stl::move(pivot);
+  return tiny_stl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// Partition around the pivot at `first`, the elements equal to the pivot go
+// to the left. It is used when the pivot equals the element before the range,
+// so the left part is all equal and needs no further sorting.
 template <class RandomIter, class Compared>
-void final_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
-  if (static_cast<size_t>(last - first) > kSmallSectionSize) {
-    tiny_stl::insertion_sort(first, first + kSmallSectionSize, comp);
-    tiny_stl::unchecked_insertion_sort(first + kSmallSectionSize, last, comp);
+RandomIter pdq_partition_left(RandomIter first, RandomIter last,
+                              Compared &comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto begin = first;
+  const auto end = last;
+  T pivot = tiny_stl::move(*first);
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
   } else {
-    tiny_stl::insertion_sort(first, last, comp);
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  while (first < last) {
+    tiny_stl::iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  *begin = tiny_stl::move(*last);
+  *last = tiny_stl::move(pivot);
+  return last;
+}
+
+// Pattern-defeating quicksort: the pivot is a median of three or a ninther,
+// a partition which swapped nothing is finished by a bounded insertion sort,
+// runs of elements equal to the previous pivot are split off in one pass,
+// and unbalanced partitions shuffle a few elements, falling back to heap sort
+// once they happened `bad_allowed` times.
+template <bool Branchless, class RandomIter, class Compared>
+void pdq_sort_loop(RandomIter first, RandomIter last, Compared &comp,
+                   size_t bad_allowed, bool leftmost) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  constexpr auto insertion_size = static_cast<Distance>(kPdqInsertionSortSize);
+  constexpr auto ninther_size = static_cast<Distance>(kPdqNintherSize);
+  constexpr auto small_size =
+      static_cast<Distance>(small_sort_size<RandomIter, Compared>());
+  while (true) {
+    const Distance size = last - first;
+    if constexpr (small_size > 0) {
+      if (size <= small_size) {
+        tiny_stl::small_sort(first, last, comp);
+        return;
+      }
+    }
+    if (size < insertion_size) {
+      if (leftmost) {
+        tiny_stl::pdq_insertion_sort<false>(first, last, comp);
+      } else {
+        tiny_stl::pdq_insertion_sort<true>(first, last, comp);
+      }
+      return;
+    }
+
+    const Distance half = size / 2;
+    if (size > ninther_size) {
+      tiny_stl::pdq_sort3(first, first + half, last - 1, comp);
+      tiny_stl::pdq_sort3(first + 1, first + (half - 1), last - 2, comp);
+      tiny_stl::pdq_sort3(first + 2, first + (half + 1), last - 3, comp);
+      tiny_stl::pdq_sort3(first + (half - 1), first + half,
+                          first + (half + 1), comp);
+      tiny_stl::iter_swap(first, first + half);
+    } else {
+      tiny_stl::pdq_sort3(first + half, first, last - 1, comp);
+    }
+
+    // The element before the range is not greater than any of it, if it is
+    // not less than the pivot either, the pivot is a repeated value.
+    if (!leftmost && !comp(*(first - 1), *first)) {
+      first = tiny_stl::pdq_partition_left(first, last, comp) + 1;
+      continue;
+    }
+
+    const auto part =
+        tiny_stl::pdq_partition_right<Branchless>(first, last, comp);
+    const auto pivot_pos = part.first;
+    const Distance l_size = pivot_pos - first;
+    const Distance r_size = last - (pivot_pos + 1);
+    if (l_size < size / 8 || r_size < size / 8) {
+      if (--bad_allowed == 0) {
+        tiny_stl::partial_sort(first, last, last, comp);
+        return;
+      }
+      // Break the patterns which led to the bad pivot.
+      if (l_size >= insertion_size) {
+        tiny_stl::iter_swap(first, first + l_size / 4);
+        tiny_stl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > ninther_size) {
+          tiny_stl::iter_swap(first + 1, first + (l_size / 4 + 1));
+          tiny_stl::iter_swap(first + 2, first + (l_size / 4 + 2));
+          tiny_stl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+          tiny_stl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+      }
+      if (r_size >= insertion_size) {
+        tiny_stl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        tiny_stl::iter_swap(last - 1, last - r_size / 4);
+        if (r_size > ninther_size) {
+          tiny_stl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+          tiny_stl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+          tiny_stl::iter_swap(last - 2, last - (1 + r_size / 4));
+          tiny_stl::iter_swap(last - 3, last - (2 + r_size / 4));
+        }
+      }
+    } else if (part.second &&
+               tiny_stl::pdq_partial_insertion_sort(first, pivot_pos, comp) &&
+               tiny_stl::pdq_partial_insertion_sort(pivot_pos + 1, last,
+                                                    comp)) {
+      // Nothing was swapped and both sides were nearly sorted.
+      return;
+    }
+
+    tiny_stl::pdq_sort_loop<Branchless>(first, pivot_pos, comp, bad_allowed,
+                                        leftmost);
+    first = pivot_pos + 1;
+    leftmost = false;
   }
 }
 
 template <class RandomIter, class Compared>
 void sort(RandomIter first, RandomIter last, Compared comp) {
-  if (first != last) {
-    tiny_stl::intro_sort(first, last, slg2(last - first) * 2, comp);
-    tiny_stl::final_insertion_sort(first, last, comp);
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto n = static_cast<size_t>(last - first);
+  if (n < 2)
+    return;
+  tiny_stl::pdq_sort_loop<is_branchless_comparable<T, Compared>::value>(
+      first, last, comp, tiny_stl::slg2(n), true);
+}
+
+template <class RandomIter> void sort(RandomIter first, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::sort(first, last, tiny_stl::less<T>());
+}
+
+// Runs shorter than this are extended by insertion sort in `stable_sort`.
+constexpr static size_t kStableSortMinRun = 32;
+// After this many wins in a row, a merge gallops over the winning run.
+constexpr static size_t kStableSortGallop = 7;
+
+// The same as `gallop_bound`, searching from the back when the answer is near
+// `last`.
+template <bool Upper, class RandomIter, class T, class Compared>
+RandomIter gallop_bound_back(RandomIter first, RandomIter last, const T &value,
+                             Compared &comp) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  const Distance n = last - first;
+  Distance bound = 1;
+  while (bound <= n &&
+         (Upper ? comp(value, last[-bound]) : !comp(last[-bound], value))) {
+    bound *= 2;
+  }
+  const auto lo = last - (bound - 1 < n ? bound - 1 : n);
+  const auto hi = last - bound / 2;
+  return Upper ? tiny_stl::upper_bound(lo, hi, value, comp)
+               : tiny_stl::lower_bound(lo, hi, value, comp);
+}
+
+// Merge the left run, moved into the buffer, with the right run from the
+// front. Once a run wins `kStableSortGallop` times in a row, whole blocks are
+// found by galloping and moved at once.
+template <class RandomIter, class Pointer, class Compared>
+void gallop_merge_lo(RandomIter first, RandomIter middle, RandomIter last,
+                     Pointer buffer, Compared &comp) {
+  Pointer left = buffer;
+  Pointer left_end = tiny_stl::move(first, middle, buffer);
+  auto right = middle;
+  auto out = first;
+  while (left != left_end && right != last) {
+    size_t left_wins = 0;
+    size_t right_wins = 0;
+    while (left != left_end && right != last &&
+           left_wins < kStableSortGallop && right_wins < kStableSortGallop) {
+      if (comp(*right, *left)) {
+        *out++ = tiny_stl::move(*right++);
+        ++right_wins;
+        left_wins = 0;
+      } else {
+        *out++ = tiny_stl::move(*left++);
+        ++left_wins;
+        right_wins = 0;
+      }
+    }
+    while (left != left_end && right != last) {
+      auto left_cut =
+          tiny_stl::gallop_bound<true>(left, left_end, *right, comp);
+      const auto left_count = static_cast<size_t>(left_cut - left);
+      out = tiny_stl::move(left, left_cut, out);
+      left = left_cut;
+      if (left == left_end)
+        break;
+      auto right_cut = tiny_stl::gallop_bound<false>(right, last, *left, comp);
+      const auto right_count = static_cast<size_t>(right_cut - right);
+      out = tiny_stl::move(right, right_cut, out);
+      right = right_cut;
+      if (left_count < kStableSortGallop && right_count < kStableSortGallop)
+        break;
+    }
+  }
+  // What is left of the right run is already in place.
+  tiny_stl::move(left, left_end, out);
+}
+
+// Merge the right run, moved into the buffer, with the left run from the back.
+template <class RandomIter, class Pointer, class Compared>
+void gallop_merge_hi(RandomIter first, RandomIter middle, RandomIter last,
+                     Pointer buffer, Compared &comp) {
+  Pointer right = buffer;
+  Pointer right_end = tiny_stl::move(middle, last, buffer);
+  auto left_end = middle;
+  auto out = last;
+  while (right != right_end && left_end != first) {
+    size_t left_wins = 0;
+    size_t right_wins = 0;
+    while (right != right_end && left_end != first &&
+           left_wins < kStableSortGallop && right_wins < kStableSortGallop) {
+      if (comp(*(right_end - 1), *(left_end - 1))) {
+        *--out = tiny_stl::move(*--left_end);
+        ++left_wins;
+        right_wins = 0;
+      } else {
+        *--out = tiny_stl::move(*--right_end);
+        ++right_wins;
+        left_wins = 0;
+      }
+    }
+    while (right != right_end && left_end != first) {
+      auto right_cut = tiny_stl::gallop_bound_back<false>(
+          right, right_end, *(left_end - 1), comp);
+      const auto right_count = static_cast<size_t>(right_end - right_cut);
+      out = tiny_stl::move_backward(right_cut, right_end, out);
+      right_end = right_cut;
+      if (right == right_end)
+        break;
+      auto left_cut = tiny_stl::gallop_bound_back<true>(
+          first, left_end, *(right_end - 1), comp);
+      const auto left_count = static_cast<size_t>(left_end - left_cut);
+      out = tiny_stl::move_backward(left_cut, left_end, out);
+      left_end = left_cut;
+      if (left_count < kStableSortGallop && right_count < kStableSortGallop)
+        break;
+    }
+  }
+  // What is left of the left run is already in place.
+  tiny_stl::move_backward(right, right_end, out);
+}
+
+// Merge two adjacent sorted runs. The elements already in place at both ends
+// are skipped first, then the shorter rest goes through the buffer, or the
+// merge falls back to `merge_adaptive` and `merge_without_buffer` when the
+// buffer is too short.
+template <class RandomIter, class Pointer, class Distance, class Compared>
+void stable_sort_merge(RandomIter first, RandomIter middle, RandomIter last,
+                       Pointer buffer, Distance buffer_size, Compared &comp) {
+  first = tiny_stl::gallop_bound<true>(first, middle, *middle, comp);
+  if (first == middle)
+    return;
+  last = tiny_stl::gallop_bound_back<false>(middle, last, *(middle - 1), comp);
+  const Distance len1 = middle - first;
+  const Distance len2 = last - middle;
+  if (len1 <= len2 && len1 <= buffer_size) {
+    tiny_stl::gallop_merge_lo(first, middle, last, buffer, comp);
+  } else if (len2 <= buffer_size) {
+    tiny_stl::gallop_merge_hi(first, middle, last, buffer, comp);
+  } else if (buffer_size > 0) {
+    tiny_stl::merge_adaptive(first, middle, last, len1, len2, buffer,
+                             buffer_size, comp);
+  } else {
+    tiny_stl::merge_without_buffer(first, middle, last, len1, len2, comp);
+  }
+}
+
+// Find the run starting at `begin`: a strictly descending run is reversed,
+// which keeps the sort stable, and a short run is extended by insertion sort.
+template <class RandomIter, class Compared>
+size_t stable_sort_run(RandomIter first, size_t begin, size_t n,
+                       Compared &comp) {
+  size_t end = begin + 1;
+  if (end == n)
+    return n;
+  if (comp(first[end], first[end - 1])) {
+    while (end < n && comp(first[end], first[end - 1]))
+      ++end;
+    tiny_stl::reverse(first + begin, first + end);
+  } else {
+    while (end < n && !comp(first[end], first[end - 1]))
+      ++end;
+  }
+  if (end - begin < kStableSortMinRun) {
+    end = begin + kStableSortMinRun < n ? begin + kStableSortMinRun : n;
+    // Equal integers or pointers can not be told apart, so the unstable
+    // small sort is stable enough for them.
+    using T = typename iterator_traits<RandomIter>::value_type;
+    if constexpr ((std::is_integral_v<T> || std::is_pointer_v<T>) &&
+                  small_sort_size<RandomIter, Compared>() >=
+                      kStableSortMinRun) {
+      tiny_stl::small_sort(first + begin, first + end, comp);
+    } else {
+      tiny_stl::pdq_insertion_sort<false>(first + begin, first + end, comp);
+    }
+  }
+  return end;
+}
+
+// The depth of the node between the runs [begin1, begin2) and [begin2, end2)
+// in the perfectly balanced merge tree over [0, n), from the powersort paper:
+// the first bit where the binary fractions of the two run midpoints differ.
+inline size_t powersort_node_power(size_t begin1, size_t begin2, size_t end2,
+                                   size_t n) {
+  size_t a = begin1 + begin2;
+  size_t b = begin2 + end2;
+  size_t power = 0;
+  while (true) {
+    ++power;
+    if (a >= n) {
+      a -= n;
+      b -= n;
+    } else if (b >= n) {
+      return power;
+    }
+    a <<= 1;
+    b <<= 1;
+  }
+}
+
+// Powersort: natural runs are found from left to right, and each pair of
+// neighbouring runs is merged in the order given by its node power, which
+// makes the merges nearly optimal for the run lengths.
+template <class RandomIter, class Compared>
+void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  struct run {
+    size_t begin;
+    size_t end;
+    size_t power;
+  };
+
+  const auto n = static_cast<size_t>(last - first);
+  if (n < 2)
+    return;
+  temporary_buffer<RandomIter, T> buf(first, first + (n + 1) / 2);
+  T *buffer = buf.size() > 0 ? buf.begin() : nullptr;
+  const auto merge = [&](size_t begin, size_t middle, size_t end) {
+    tiny_stl::stable_sort_merge(first + begin, first + middle, first + end,
+                                buffer, buf.size(), comp);
+  };
+
+  // The powers on the stack strictly increase, so it never holds more runs
+  // than there are bits in `size_t`.
+  run stack[sizeof(size_t) * 8 + 1];
+  size_t top = 0;
+  size_t begin1 = 0;
+  size_t end1 = tiny_stl::stable_sort_run(first, 0, n, comp);
+  while (end1 < n) {
+    const size_t end2 = tiny_stl::stable_sort_run(first, end1, n, comp);
+    const size_t power = tiny_stl::powersort_node_power(begin1, end1, end2, n);
+    while (top > 0 && stack[top - 1].power > power) {
+      --top;
+      merge(stack[top].begin, stack[top].end, end1);
+      begin1 = stack[top].begin;
+    }
+    stack[top++] = run{begin1, end1, power};
+    begin1 = end1;
+    end1 = end2;
+  }
+  while (top > 0) {
+    --top;
+    merge(stack[top].begin, stack[top].end, n);
   }
 }
 
 template <class RandomIter>
-void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
-  if (nth == last)
+void stable_sort(RandomIter first, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::stable_sort(first, last, tiny_stl::less<T>());
+}
+
+// The minimum number of elements sorted by one thread of a parallel sort.
+constexpr static size_t kParallelSortGrain = 1 << 14;
+// The number of samples taken for each bucket of a parallel sort.
+constexpr static size_t kParallelSortOversample = 16;
+// The number of buckets of a parallel sort for each thread.
+constexpr static size_t kParallelSortBucketsPerThread = 4;
+// How many times a parallel sort may split an oversized bucket again.
+constexpr static size_t kParallelSortMaxDepth = 2;
+// The most splitters of a parallel sort, so that the `2 * m + 1` bucket ids
+// fit the 16-bit ids kept for every element.
+constexpr static size_t kParallelSortMaxSplitters = 0x7FFF;
+
+template <class T, class Compared>
+size_t sample_sort_bucket(const T &value, const T *splitters, size_t m,
+                          Compared &comp) {
+  size_t lo = 0;
+  size_t hi = m;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (comp(splitters[mid], value)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  // Odd buckets hold the elements equal to a splitter, and need no sorting.
+  return lo < m && !comp(value, splitters[lo]) ? 2 * lo + 1 : 2 * lo;
+}
+
+// Parallel sample sort: the elements are classified into buckets by splitters
+// picked from a sorted random sample, moved bucket by bucket into a buffer and
+// back, and then the buckets are sorted by the sequential sort in parallel.
+template <class RandomIter, class Compared>
+void parallel_sample_sort(RandomIter first, RandomIter last, Compared &comp,
+                          size_t depth) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto n = static_cast<size_t>(last - first);
+  const size_t chunks = tiny_stl::parallel_chunk_count(n, kParallelSortGrain);
+  if (chunks < 2 || depth == 0) {
+    tiny_stl::sort(first, last, comp);
     return;
-  while (last - first > 3) {
-    auto cut = tiny_stl::unchecked_partition(
-        first, last,
-        tiny_stl::median(*first, *(first + (last - first) / 2), *(last - 1)));
-    if (cut <= nth)
-      first = cut;
-    else
-      last = cut;
   }
-  tiny_stl::insertion_sort(first, last);
+
+  const size_t bucket_target =
+      tiny_stl::min(chunks * kParallelSortBucketsPerThread,
+                    kParallelSortMaxSplitters + 1);
+  const size_t sample_size = bucket_target * kParallelSortOversample;
+  tiny_stl::vector<T> sample;
+  sample.reserve(sample_size);
+  std::uint64_t seed = n * 0x9E3779B97F4A7C15ull + 1;
+  for (size_t i = 0; i < sample_size; ++i) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    sample.push_back(first[static_cast<size_t>(seed % n)]);
+  }
+  tiny_stl::sort(sample.data(), sample.data() + sample_size, comp);
+  tiny_stl::vector<T> splitters;
+  for (size_t i = 1; i < bucket_target; ++i) {
+    const T &splitter = sample[i * kParallelSortOversample];
+    if (splitters.empty() || comp(splitters.back(), splitter)) {
+      splitters.push_back(splitter);
+    }
+  }
+  const size_t m = splitters.size();
+  const size_t buckets = 2 * m + 1;
+
+  std::unique_ptr<std::uint16_t[]> ids(new std::uint16_t[n]);
+  std::unique_ptr<size_t[]> offsets(new size_t[chunks * buckets]());
+  tiny_stl::parallel_for(chunks, [&](size_t c) {
+    size_t *count = offsets.get() + c * buckets;
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      const size_t b =
+          tiny_stl::sample_sort_bucket(first[i], splitters.data(), m, comp);
+      ids[i] = static_cast<std::uint16_t>(b);
+      ++count[b];
+    }
+  });
+
+  // Turn the counts into the positions of each chunk inside each bucket.
+  std::unique_ptr<size_t[]> bucket_begin(new size_t[buckets + 1]);
+  size_t sum = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    bucket_begin[b] = sum;
+    for (size_t c = 0; c < chunks; ++c) {
+      const size_t count = offsets[c * buckets + b];
+      offsets[c * buckets + b] = sum;
+      sum += count;
+    }
+  }
+  bucket_begin[buckets] = n;
+
+  T *buffer = nullptr;
+  try {
+    buffer = tiny_stl::allocator<T>::allocate(n);
+  } catch (const std::bad_alloc &) {
+    tiny_stl::sort(first, last, comp);
+    return;
+  }
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t c) {
+    size_t *offset = offsets.get() + c * buckets;
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      tiny_stl::construct(buffer + offset[ids[i]]++, tiny_stl::move(first[i]));
+    }
+  });
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t c) {
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      first[i] = tiny_stl::move(buffer[i]);
+      tiny_stl::destroy(buffer + i);
+    }
+  });
+  tiny_stl::allocator<T>::deallocate(buffer, n);
+  ids.reset();
+  offsets.reset();
+
+  const size_t large_bucket = n / chunks * 2;
+  task_group group;
+  for (size_t b = 0; b < buckets; b += 2) {
+    const size_t lo = bucket_begin[b];
+    const size_t hi = bucket_begin[b + 1];
+    if (hi - lo < 2) {
+      continue;
+    }
+    group.run([first, lo, hi, large_bucket, depth, &comp] {
+      if (hi - lo > large_bucket) {
+        tiny_stl::parallel_sample_sort(first + lo, first + hi, comp, depth - 1);
+      } else {
+        tiny_stl::sort(first + lo, first + hi, comp);
+      }
+    });
+  }
+  group.wait();
+}
+
+template <class ExecutionPolicy, class RandomIter, class Compared>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+sort(ExecutionPolicy &&, RandomIter first, RandomIter last, Compared comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  // The elements are moved to a buffer and back, a throwing move could lose
+  // some of them half way. The sample and the splitters are copies, so a
+  // move-only type is sorted sequentially.
+  if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>,
+                               parallel_policy> &&
+                tiny_stl::is_random_iterator<RandomIter>::value &&
+                std::is_copy_constructible_v<T> &&
+                std::is_nothrow_move_constructible_v<T> &&
+                std::is_nothrow_move_assignable_v<T>) {
+    tiny_stl::parallel_sample_sort(first, last, comp, kParallelSortMaxDepth);
+  } else {
+    tiny_stl::sort(first, last, comp);
+  }
+}
+
+template <class ExecutionPolicy, class RandomIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::sort(tiny_stl::forward<ExecutionPolicy>(policy), first, last,
+                 tiny_stl::less<T>());
+}
+
+// Parallel shuffle: every element is sent to a random bucket, one per chunk,
+// by the chunks in parallel, and then every bucket is shuffled on its own.
+// The bucket sizes are multinomial and each bucket is uniformly ordered, so
+// the whole permutation is uniform. Every chunk draws from its own stream of
+// an engine seeded by `g`, the streams are `2^128` steps apart.
+template <class RandomIter, class URBG>
+void parallel_shuffle(RandomIter first, RandomIter last, URBG &g) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto n = static_cast<size_t>(last - first);
+  const size_t grain =
+      kParallelGrainBytes / sizeof(T) > 0 ? kParallelGrainBytes / sizeof(T) : 1;
+  size_t chunks = tiny_stl::parallel_chunk_count(n, grain);
+  chunks = chunks < 0xFFFF ? chunks : 0xFFFF;
+  if (chunks < 2) {
+    tiny_stl::shuffle(first, last, g);
+    return;
+  }
+
+  std::vector<xoshiro256starstar> engines(
+      chunks, xoshiro256starstar(tiny_stl::uniform_bounded(
+                  g, std::numeric_limits<std::uint64_t>::max())));
+  for (size_t c = 1; c < chunks; ++c) {
+    engines[c] = engines[c - 1];
+    engines[c].jump();
+  }
+
+  std::unique_ptr<std::uint16_t[]> ids(new std::uint16_t[n]);
+  std::unique_ptr<size_t[]> offsets(new size_t[chunks * chunks]());
+  tiny_stl::parallel_for(chunks, [&](size_t c) {
+    size_t *count = offsets.get() + c * chunks;
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      const auto b = tiny_stl::uniform_bounded(engines[c], chunks);
+      ids[i] = static_cast<std::uint16_t>(b);
+      ++count[b];
+    }
+  });
+
+  // Turn the counts into the positions of each chunk inside each bucket.
+  std::unique_ptr<size_t[]> bucket_begin(new size_t[chunks + 1]);
+  size_t sum = 0;
+  for (size_t b = 0; b < chunks; ++b) {
+    bucket_begin[b] = sum;
+    for (size_t c = 0; c < chunks; ++c) {
+      const size_t count = offsets[c * chunks + b];
+      offsets[c * chunks + b] = sum;
+      sum += count;
+    }
+  }
+  bucket_begin[chunks] = n;
+
+  T *buffer = nullptr;
+  try {
+    buffer = tiny_stl::allocator<T>::allocate(n);
+  } catch (const std::bad_alloc &) {
+    tiny_stl::shuffle(first, last, g);
+    return;
+  }
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t c) {
+    size_t *offset = offsets.get() + c * chunks;
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      tiny_stl::construct(buffer + offset[ids[i]]++, tiny_stl::move(first[i]));
+    }
+  });
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t b) {
+    const size_t lo = bucket_begin[b];
+    const size_t hi = bucket_begin[b + 1];
+    tiny_stl::shuffle(buffer + lo, buffer + hi, engines[b]);
+    for (size_t i = lo; i < hi; ++i) {
+      first[i] = tiny_stl::move(buffer[i]);
+      tiny_stl::destroy(buffer + i);
+    }
+  });
+  tiny_stl::allocator<T>::deallocate(buffer, n);
+}
+
+template <class ExecutionPolicy, class RandomIter, class URBG>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+shuffle(ExecutionPolicy &&, RandomIter first, RandomIter last, URBG &&g) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  // The elements are moved to a buffer and back, a throwing move could lose
+  // some of them half way.
+  if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>,
+                               parallel_policy> &&
+                tiny_stl::is_random_iterator<RandomIter>::value &&
+                std::is_nothrow_move_constructible_v<T> &&
+                std::is_nothrow_move_assignable_v<T>) {
+    tiny_stl::parallel_shuffle(first, last, g);
+  } else {
+    tiny_stl::shuffle(first, last, g);
+  }
+}
+
+// The minimum number of bytes merged by one thread of a parallel merge.
+constexpr static size_t kParallelMergeGrainBytes = kParallelGrainBytes;
+
+// Merge path: the number of elements of the first range among the first
+// `diagonal` elements of their stable merge, found by a binary search along
+// the diagonal. Splitting both ranges there gives two independent merges.
+template <class RandomIter1, class RandomIter2, class Compared>
+size_t merge_path_split(RandomIter1 first1, size_t len1, RandomIter2 first2,
+                        size_t len2, size_t diagonal, Compared &comp) {
+  size_t lo = diagonal > len2 ? diagonal - len2 : 0;
+  size_t hi = diagonal < len1 ? diagonal : len1;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    // The element of the first range goes first on ties.
+    if (comp(first2[diagonal - mid - 1], first1[mid])) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+// The number of chunks of a parallel merge of `n` elements of type `T`.
+template <class T> size_t parallel_merge_chunks(size_t n) {
+  const size_t grain = kParallelMergeGrainBytes / sizeof(T) > 0
+                           ? kParallelMergeGrainBytes / sizeof(T)
+                           : 1;
+  return tiny_stl::parallel_chunk_count(n, grain);
+}
+
+// Parallel merge: the output is cut into equal chunks, and each chunk merges
+// the pieces of the two ranges the merge path assigns to it.
+template <class RandomIter1, class RandomIter2, class RandomIter3,
+          class Compared>
+RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1,
+                           RandomIter2 first2, RandomIter2 last2,
+                           RandomIter3 result, Compared &comp) {
+  using T = typename iterator_traits<RandomIter3>::value_type;
+  const auto len1 = static_cast<size_t>(last1 - first1);
+  const auto len2 = static_cast<size_t>(last2 - first2);
+  const size_t n = len1 + len2;
+  const size_t chunks = tiny_stl::parallel_merge_chunks<T>(n);
+  if (chunks < 2 || len1 == 0 || len2 == 0) {
+    return tiny_stl::merge(first1, last1, first2, last2, result, comp);
+  }
+  tiny_stl::parallel_for(chunks, [&](size_t c) {
+    const size_t begin = tiny_stl::chunk_begin(n, chunks, c);
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    const size_t i = tiny_stl::merge_path_split(first1, len1, first2, len2,
+                                                begin, comp);
+    const size_t j = tiny_stl::merge_path_split(first1, len1, first2, len2,
+                                                end, comp);
+    tiny_stl::merge(first1 + i, first1 + j, first2 + (begin - i),
+                    first2 + (end - j), result + begin, comp);
+  });
+  return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter1, class InputIter2,
+          class OutputIter, class Compared>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, OutputIter>
+merge(ExecutionPolicy &&, InputIter1 first1, InputIter1 last1,
+      InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+  if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>,
+                               parallel_policy> &&
+                tiny_stl::is_random_iterator<InputIter1>::value &&
+                tiny_stl::is_random_iterator<InputIter2>::value &&
+                tiny_stl::is_random_iterator<OutputIter>::value) {
+    return tiny_stl::parallel_merge(first1, last1, first2, last2, result,
+                                    comp);
+  } else {
+    return tiny_stl::merge(first1, last1, first2, last2, result, comp);
+  }
+}
+
+template <class ExecutionPolicy, class InputIter1, class InputIter2,
+          class OutputIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, OutputIter>
+merge(ExecutionPolicy &&policy, InputIter1 first1, InputIter1 last1,
+      InputIter2 first2, InputIter2 last2, OutputIter result) {
+  using T = typename iterator_traits<InputIter1>::value_type;
+  return tiny_stl::merge(tiny_stl::forward<ExecutionPolicy>(policy), first1,
+                         last1, first2, last2, result, tiny_stl::less<T>());
+}
+
+// Parallel in-place merge: every comparison is made first, while the range is
+// untouched, and records which range each output element comes from. Then the
+// range is moved to a buffer by chunks and merged back by those records, which
+// can not throw. Without the memory for the records and a buffer for the
+// whole range it is left to `merge_adaptive`, with whatever buffer there is.
+template <class RandomIter, class Compared>
+void parallel_inplace_merge(RandomIter first, RandomIter middle,
+                            RandomIter last, Compared &comp) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  const auto len1 = static_cast<size_t>(middle - first);
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t len2 = n - len1;
+  const size_t chunks = tiny_stl::parallel_merge_chunks<T>(n);
+  if (chunks < 2) {
+    tiny_stl::inplace_merge(first, middle, last, comp);
+    return;
+  }
+  std::unique_ptr<bool[]> from_right;
+  std::unique_ptr<size_t[]> splits;
+  try {
+    from_right.reset(new bool[n]);
+    splits.reset(new size_t[chunks + 1]);
+  } catch (const std::bad_alloc &) {
+    tiny_stl::inplace_merge(first, middle, last, comp);
+    return;
+  }
+  splits[chunks] = len1;
+  tiny_stl::parallel_for(chunks, [&](size_t c) {
+    const size_t begin = tiny_stl::chunk_begin(n, chunks, c);
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    const size_t i =
+        tiny_stl::merge_path_split(first, len1, middle, len2, begin, comp);
+    const size_t j =
+        tiny_stl::merge_path_split(first, len1, middle, len2, end, comp);
+    splits[c] = i;
+    size_t l = i;
+    size_t r = begin - i;
+    const size_t r_end = end - j;
+    for (size_t k = begin; k < end; ++k) {
+      const bool right = l == j || (r != r_end && comp(middle[r], first[l]));
+      from_right[k] = right;
+      if (right) {
+        ++r;
+      } else {
+        ++l;
+      }
+    }
+  });
+
+  T *buffer = nullptr;
+  try {
+    buffer = tiny_stl::allocator<T>::allocate(n);
+  } catch (const std::bad_alloc &) {
+    tiny_stl::inplace_merge(first, middle, last, comp);
+    return;
+  }
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t c) {
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    for (size_t i = tiny_stl::chunk_begin(n, chunks, c); i < end; ++i) {
+      tiny_stl::construct(buffer + i, tiny_stl::move(first[i]));
+    }
+  });
+  T *const left = buffer;
+  T *const right = buffer + len1;
+  tiny_stl::parallel_for_nothrow(chunks, [&](size_t c) {
+    const size_t begin = tiny_stl::chunk_begin(n, chunks, c);
+    const size_t end = tiny_stl::chunk_begin(n, chunks, c + 1);
+    const size_t i = splits[c];
+    const size_t j = splits[c + 1];
+    T *l = left + i;
+    T *r = right + (begin - i);
+    for (size_t k = begin; k < end; ++k) {
+      first[k] = tiny_stl::move(from_right[k] ? *r++ : *l++);
+    }
+    tiny_stl::destroy(left + i, left + j);
+    tiny_stl::destroy(right + (begin - i), right + (end - j));
+  });
+  tiny_stl::allocator<T>::deallocate(buffer, n);
+}
+
+template <class ExecutionPolicy, class BidirectionalIter, class Compared>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+inplace_merge(ExecutionPolicy &&, BidirectionalIter first,
+              BidirectionalIter middle, BidirectionalIter last,
+              Compared comp) {
+  using T = typename iterator_traits<BidirectionalIter>::value_type;
+  // The elements are moved to a buffer and back, a throwing move could lose
+  // some of them half way.
+  if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>,
+                               parallel_policy> &&
+                tiny_stl::is_random_iterator<BidirectionalIter>::value &&
+                std::is_nothrow_move_constructible_v<T> &&
+                std::is_nothrow_move_assignable_v<T>) {
+    if (first == middle || middle == last)
+      return;
+    tiny_stl::parallel_inplace_merge(first, middle, last, comp);
+  } else {
+    tiny_stl::inplace_merge(first, middle, last, comp);
+  }
+}
+
+template <class ExecutionPolicy, class BidirectionalIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+inplace_merge(ExecutionPolicy &&policy, BidirectionalIter first,
+              BidirectionalIter middle, BidirectionalIter last) {
+  using T = typename iterator_traits<BidirectionalIter>::value_type;
+  tiny_stl::inplace_merge(tiny_stl::forward<ExecutionPolicy>(policy), first,
+                          middle, last, tiny_stl::less<T>());
+}
+
+// Ranges shorter than this are sorted by insertion sort in a radix sort.
+constexpr static size_t kRadixSortInsertionSize = 64;
+// Ranges at least this long are sorted with 11-bit digits instead of 8-bit.
+constexpr static size_t kRadixSortWideDigitSize = 1 << 16;
+
+// Map an arithmetic key to an unsigned integer with the same order: the sign
+// bit of signed integers is flipped, all the bits of negative floating-point
+// numbers are flipped and only the sign bit of the positive ones, so -0.0
+// comes before 0.0 and NaNs go to the ends by their sign.
+template <class Key> auto radix_key(Key key) noexcept {
+  static_assert(std::is_arithmetic_v<Key> && sizeof(Key) <= 8,
+                "radix sort needs integral or floating-point keys");
+  using U = typename uint_of_size<sizeof(Key)>::type;
+  constexpr U sign = static_cast<U>(U(1) << (sizeof(U) * 8 - 1));
+  if constexpr (std::is_floating_point_v<Key>) {
+    U bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return static_cast<U>(bits & sign ? ~bits : bits | sign);
+  } else if constexpr (std::is_signed_v<Key>) {
+    return static_cast<U>(static_cast<U>(key) ^ sign);
+  } else {
+    return static_cast<U>(key);
+  }
+}
+
+template <class KeyOf> struct radix_key_less {
+  KeyOf &key_of;
+
+  template <class T> bool operator()(const T &left, const T &right) const {
+    return tiny_stl::radix_key(key_of(left)) <
+           tiny_stl::radix_key(key_of(right));
+  }
+};
+
+// Move every element to its bucket by one digit, constructing the elements
+// in place when `result` is uninitialized memory.
+template <bool Construct, class InputIter, class OutputIter, class KeyOf>
+void radix_scatter(InputIter first, InputIter last, OutputIter result,
+                   size_t *offset, size_t shift, size_t mask, KeyOf &key_of) {
+  for (; first != last; ++first) {
+    const size_t digit =
+        static_cast<size_t>(tiny_stl::radix_key(key_of(*first)) >> shift) &
+        mask;
+    if constexpr (Construct) {
+      tiny_stl::construct(&result[offset[digit]++], tiny_stl::move(*first));
+    } else {
+      result[offset[digit]++] = tiny_stl::move(*first);
+    }
+  }
+}
+
+// LSD radix sort: the histograms of all the digits are counted in one pass,
+// then the elements are scattered digit by digit between the range and the
+// buffer, skipping the digits shared by all the elements. The buffer is
+// uninitialized, the elements are constructed in it by the first scatter and
+// destroyed at the end, or when a later scatter throws. A `key_of` which
+// throws does so in the counting pass, before any element is constructed.
+template <size_t Bits, class RandomIter, class T, class KeyOf>
+void lsd_radix_sort(RandomIter first, size_t n, T *buffer, KeyOf &key_of) {
+  using U = decltype(tiny_stl::radix_key(key_of(*first)));
+  constexpr size_t passes = (sizeof(U) * 8 + Bits - 1) / Bits;
+  constexpr size_t buckets = size_t(1) << Bits;
+  constexpr size_t mask = buckets - 1;
+  std::unique_ptr<size_t[]> counts(new size_t[passes * buckets]());
+  for (size_t i = 0; i < n; ++i) {
+    const U key = tiny_stl::radix_key(key_of(first[i]));
+    for (size_t p = 0; p < passes; ++p) {
+      ++counts[p * buckets + (static_cast<size_t>(key >> (p * Bits)) & mask)];
+    }
+  }
+
+  bool in_buffer = false;
+  bool constructed = false;
+  try {
+    for (size_t p = 0; p < passes; ++p) {
+      size_t *offset = counts.get() + p * buckets;
+      bool constant = false;
+      size_t sum = 0;
+      for (size_t b = 0; b < buckets; ++b) {
+        const size_t count = offset[b];
+        if (count == n) {
+          constant = true;
+          break;
+        }
+        offset[b] = sum;
+        sum += count;
+      }
+      if (constant) {
+        continue;
+      }
+      if (in_buffer) {
+        tiny_stl::radix_scatter<false>(buffer, buffer + n, first, offset,
+                                       p * Bits, mask, key_of);
+      } else if (constructed) {
+        tiny_stl::radix_scatter<false>(first, first + n, buffer, offset,
+                                       p * Bits, mask, key_of);
+      } else {
+        tiny_stl::radix_scatter<true>(first, first + n, buffer, offset,
+                                      p * Bits, mask, key_of);
+        constructed = true;
+      }
+      in_buffer = !in_buffer;
+    }
+    if (in_buffer) {
+      tiny_stl::move(buffer, buffer + n, first);
+    }
+  } catch (...) {
+    if (constructed) {
+      tiny_stl::destroy(buffer, buffer + n);
+    }
+    throw;
+  }
+  if (constructed) {
+    tiny_stl::destroy(buffer, buffer + n);
+  }
+}
+
+// American flag sort: an in-place MSD radix sort with 8-bit digits, each
+// element is swapped straight into its bucket and the buckets are sorted by
+// the next digit.
+template <class RandomIter, class KeyOf>
+void american_flag_sort(RandomIter first, RandomIter last, size_t shift,
+                        KeyOf &key_of) {
+  constexpr size_t buckets = 256;
+  const auto n = static_cast<size_t>(last - first);
+  if (n < kRadixSortInsertionSize) {
+    tiny_stl::insertion_sort(first, last, radix_key_less<KeyOf>{key_of});
+    return;
+  }
+  const auto digit = [&key_of, &shift](const auto &value) {
+    return static_cast<size_t>(tiny_stl::radix_key(key_of(value)) >> shift) &
+           (buckets - 1);
+  };
+
+  size_t count[buckets];
+  for (;;) {
+    tiny_stl::fill_n(count, buckets, size_t(0));
+    for (size_t i = 0; i < n; ++i) {
+      ++count[digit(first[i])];
+    }
+    if (count[digit(*first)] != n) {
+      break;
+    }
+    if (shift == 0) {
+      return;
+    }
+    shift -= 8;
+  }
+
+  size_t end[buckets];
+  size_t next[buckets];
+  size_t sum = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    next[b] = sum;
+    sum += count[b];
+    end[b] = sum;
+  }
+  for (size_t b = 0; b < buckets; ++b) {
+    while (next[b] < end[b]) {
+      size_t d = digit(first[next[b]]);
+      while (d != b) {
+        tiny_stl::iter_swap(first + next[b], first + next[d]++);
+        d = digit(first[next[b]]);
+      }
+      ++next[b];
+    }
+  }
+  if (shift == 0) {
+    return;
+  }
+  size_t begin = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    if (end[b] - begin > 1) {
+      tiny_stl::american_flag_sort(first + begin, first + end[b], shift - 8,
+                                   key_of);
+    }
+    begin = end[b];
+  }
+}
+
+template <class RandomIter, class KeyOf>
+void inplace_radix_sort(RandomIter first, RandomIter last, KeyOf key_of) {
+  if (last - first < 2)
+    return;
+  using U = decltype(tiny_stl::radix_key(key_of(*first)));
+  tiny_stl::american_flag_sort(first, last, (sizeof(U) - 1) * 8, key_of);
+}
+
+template <class RandomIter>
+void inplace_radix_sort(RandomIter first, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::inplace_radix_sort(first, last, tiny_stl::identity<T>());
+}
+
+// Releases the uninitialized memory of `allocator<T>::allocate(n)`, which
+// holds no element when it is released.
+template <class T> struct allocator_deleter {
+  size_t n;
+
+  void operator()(T *ptr) const { tiny_stl::allocator<T>::deallocate(ptr, n); }
+};
+
+// A stable LSD radix sort through an uninitialized scratch buffer of `n`
+// elements. When the buffer can not be allocated, it falls back to
+// `stable_sort` by the keys, which stays stable with less memory.
+template <class RandomIter, class KeyOf>
+void radix_sort(RandomIter first, RandomIter last, KeyOf key_of) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  using U = decltype(tiny_stl::radix_key(key_of(*first)));
+  const auto n = static_cast<size_t>(last - first);
+  if (n < kRadixSortInsertionSize) {
+    tiny_stl::insertion_sort(first, last, radix_key_less<KeyOf>{key_of});
+    return;
+  }
+  std::unique_ptr<T, allocator_deleter<T>> buffer(nullptr,
+                                                  allocator_deleter<T>{n});
+  try {
+    buffer.reset(tiny_stl::allocator<T>::allocate(n));
+  } catch (const std::bad_alloc &) {
+    tiny_stl::stable_sort(first, last, radix_key_less<KeyOf>{key_of});
+    return;
+  }
+  if (n >= kRadixSortWideDigitSize && sizeof(U) >= 4) {
+    tiny_stl::lsd_radix_sort<11>(first, n, buffer.get(), key_of);
+  } else {
+    tiny_stl::lsd_radix_sort<8>(first, n, buffer.get(), key_of);
+  }
+}
+
+template <class RandomIter>
+void radix_sort(RandomIter first, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::radix_sort(first, last, tiny_stl::identity<T>());
+}
+
+// Ranges longer than this take their pivot from a Floyd-Rivest sample in
+// `nth_element`.
+constexpr static size_t kFloydRivestSize = 600;
+// The partitions which keep more than 7/8 of the range that `nth_element`
+// allows before it takes medians of medians: a constant, so that they cost
+// `O(n)` together.
+constexpr static size_t kIntroSelectBadRounds = 4;
+
+template <bool Branchless, class RandomIter, class Compared>
+void intro_select_loop(RandomIter first, RandomIter nth, RandomIter last,
+                       Compared &comp);
+
+// Floyd-Rivest: select `nth` within a sample of about `n^(2/3)` elements
+// around it, whose bounds are chosen so that the true nth element most likely
+// falls between the neighbours of the sample's nth element. The pivot is
+// moved to `first`, with an element not greater than it after `first` and an
+// element not less than it at `last - 1`.
+template <bool Branchless, class RandomIter, class Compared>
+void floyd_rivest_pivot(RandomIter first, RandomIter nth, RandomIter last,
+                        Compared &comp) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  const double n = static_cast<double>(last - first);
+  const double k = static_cast<double>(nth - first);
+  const double z = std::log(n);
+  const double s = 0.5 * std::exp(2 * z / 3);
+  double sd = 0.5 * std::sqrt(z * s * (n - s) / n);
+  if (k < n / 2)
+    sd = -sd;
+  auto left = static_cast<Distance>(k - k * s / n + sd);
+  auto right = static_cast<Distance>(k + (n - k) * s / n + sd) + 1;
+  // Keep an element on both sides of `nth` inside the sample.
+  const Distance pos = nth - first;
+  left = left < 0 ? 0 : (left > pos - 1 ? pos - 1 : left);
+  right = right > last - first ? last - first : right;
+  right = right < pos + 2 ? pos + 2 : right;
+  tiny_stl::intro_select_loop<Branchless>(first + left, nth, first + right,
+                                          comp);
+  tiny_stl::iter_swap(first + (right - 1), last - 1);
+  tiny_stl::iter_swap(first, nth);
+}
+
+// Median of medians: the medians of groups of five are gathered at the front
+// and their median is selected, which is greater than and less than at least
+// 30% of the range each, so every partition keeps at most 70% of it. The
+// pivot is laid out like `floyd_rivest_pivot`.
+template <bool Branchless, class RandomIter, class Compared>
+void median_of_medians_pivot(RandomIter first, RandomIter last,
+                             Compared &comp) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  const Distance groups = (last - first) / 5;
+  for (Distance i = 0; i < groups; ++i) {
+    auto group = first + i * 5;
+    tiny_stl::pdq_insertion_sort<false>(group, group + 5, comp);
+    tiny_stl::iter_swap(first + i, group + 2);
+  }
+  auto median = first + groups / 2;
+  tiny_stl::intro_select_loop<Branchless>(first, median, first + groups, comp);
+  tiny_stl::iter_swap(first + (groups - 1), last - 1);
+  tiny_stl::iter_swap(first, median);
+}
+
+// Introselect: quickselect on the partitions of the pattern-defeating
+// quicksort, where runs of elements equal to the previous pivot are split
+// off in one pass. Long ranges take a Floyd-Rivest pivot which lands next to
+// `nth`. Once the kept side fails to shrink by an eighth
+// `kIntroSelectBadRounds` times, the pivots become medians of medians, so the
+// selection runs in linear time.
+template <bool Branchless, class RandomIter, class Compared>
+void intro_select_loop(RandomIter first, RandomIter nth, RandomIter last,
+                       Compared &comp) {
+  using Distance = typename iterator_traits<RandomIter>::difference_type;
+  constexpr auto insertion_size = static_cast<Distance>(kPdqInsertionSortSize);
+  constexpr auto ninther_size = static_cast<Distance>(kPdqNintherSize);
+  constexpr auto floyd_rivest_size = static_cast<Distance>(kFloydRivestSize);
+  size_t bad_allowed = kIntroSelectBadRounds;
+  bool leftmost = true;
+  while (true) {
+    const Distance size = last - first;
+    if (size < insertion_size) {
+      tiny_stl::pdq_insertion_sort<false>(first, last, comp);
+      return;
+    }
+    if (nth == first) {
+      tiny_stl::iter_swap(first, tiny_stl::min_element(first, last, comp));
+      return;
+    }
+    if (nth == last - 1) {
+      tiny_stl::iter_swap(nth, tiny_stl::max_element(first, last, comp));
+      return;
+    }
+
+    const Distance half = size / 2;
+    if (bad_allowed == 0) {
+      tiny_stl::median_of_medians_pivot<Branchless>(first, last, comp);
+    } else if (size > floyd_rivest_size) {
+      tiny_stl::floyd_rivest_pivot<Branchless>(first, nth, last, comp);
+    } else if (size > ninther_size) {
+      tiny_stl::pdq_sort3(first, first + half, last - 1, comp);
+      tiny_stl::pdq_sort3(first + 1, first + (half - 1), last - 2, comp);
+      tiny_stl::pdq_sort3(first + 2, first + (half + 1), last - 3, comp);
+      tiny_stl::pdq_sort3(first + (half - 1), first + half,
+                          first + (half + 1), comp);
+      tiny_stl::iter_swap(first, first + half);
+    } else {
+      tiny_stl::pdq_sort3(first + half, first, last - 1, comp);
+    }
+
+    if (!leftmost && !comp(*(first - 1), *first)) {
+      // The pivot repeats the element before the range, the elements equal
+      // to it are gathered at the front and are all in place.
+      const auto equal_last = tiny_stl::pdq_partition_left(first, last, comp);
+      if (nth <= equal_last)
+        return;
+      first = equal_last + 1;
+      continue;
+    }
+
+    const auto pivot_pos =
+        tiny_stl::pdq_partition_right<Branchless>(first, last, comp).first;
+    if (pivot_pos == nth)
+      return;
+    if (nth < pivot_pos) {
+      last = pivot_pos;
+    } else {
+      first = pivot_pos + 1;
+      leftmost = false;
+    }
+    if (bad_allowed > 0 && last - first > size - size / 8)
+      --bad_allowed;
+  }
 }
 
 template <class RandomIter, class Compared>
 void nth_element(RandomIter first, RandomIter nth, RandomIter last,
                  Compared comp) {
-  if (nth == last)
+  using T = typename iterator_traits<RandomIter>::value_type;
+  if (nth == last || last - first < 2)
     return;
-  while (last - first > 3) {
-    auto cut = tiny_stl::unchecked_partition(
-        first, last,
-        tiny_stl::median(*first, *(first + (last - first) / 2), *(last - 1)),
-        comp);
-    if (cut <= nth)
-      first = cut;
-    else
-      last = cut;
+  tiny_stl::intro_select_loop<is_branchless_comparable<T, Compared>::value>(
+      first, nth, last, comp);
+}
+
+template <class RandomIter>
+void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  tiny_stl::nth_element(first, nth, last, tiny_stl::less<T>());
+}
+
+// Move the `k` smallest elements to the front in order, and return the end of
+// them. Unlike `partial_sort`, it costs `O(n + k log(k))`.
+template <class RandomIter, class Size, class Compared>
+RandomIter select_k(RandomIter first, RandomIter last, Size k, Compared comp) {
+  const auto n = last - first;
+  const auto count = static_cast<decltype(n)>(k) < n
+                         ? static_cast<decltype(n)>(k)
+                         : n;
+  const auto middle = first + count;
+  tiny_stl::nth_element(first, middle, last, comp);
+  tiny_stl::sort(first, middle, comp);
+  return middle;
+}
+
+template <class RandomIter, class Size>
+RandomIter select_k(RandomIter first, RandomIter last, Size k) {
+  using T = typename iterator_traits<RandomIter>::value_type;
+  return tiny_stl::select_k(first, last, k, tiny_stl::less<T>());
+}
+
+// Copy the `k` smallest elements of [first, last) to `result` in order, and
+// return the end of the copies. The input is left untouched, and is read once
+// through a buffer of at most `2k` copies: whenever it fills up, the `k`
+// smallest are kept, and only the elements below the largest of them are
+// copied from then on. It costs `O(n + k log(k))` time and `O(k)` memory.
+template <class InputIter, class OutputIter, class Size, class Compared>
+OutputIter select_k_copy(InputIter first, InputIter last, OutputIter result,
+                         Size k, Compared comp) {
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  if (!(k > Size(0)))
+    return result;
+  const auto keep = static_cast<size_t>(k);
+  tiny_stl::vector<T> buffer;
+  bool pruned = false;
+  for (; first != last; ++first) {
+    // After a pruning, the largest element kept is at `keep - 1`.
+    if (pruned && !comp(*first, buffer[keep - 1]))
+      continue;
+    buffer.push_back(*first);
+    if (buffer.size() >= keep && buffer.size() - keep == keep) {
+      tiny_stl::nth_element(buffer.data(), buffer.data() + (keep - 1),
+                            buffer.data() + buffer.size(), comp);
+      buffer.erase(buffer.begin() + static_cast<std::ptrdiff_t>(keep),
+                   buffer.end());
+      pruned = true;
+    }
   }
-  tiny_stl::insertion_sort(first, last, comp);
+  auto *data = buffer.data();
+  const auto middle = tiny_stl::select_k(data, data + buffer.size(), k, comp);
+  return tiny_stl::copy(data, middle, result);
+}
+
+template <class InputIter, class OutputIter, class Size>
+OutputIter select_k_copy(InputIter first, InputIter last, OutputIter result,
+                         Size k) {
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  return tiny_stl::select_k_copy(first, last, result, k, tiny_stl::less<T>());
 }
 
 template <class InputIter, class ForwardIter>
@@ -2002,4 +4920,6 @@ ForwardIter unique(ForwardIter first, ForwardIter last, Compared comp) {
 
 } // namespace tiny_stl
 
+#include "vector.hpp"
+
 #endif // TINY_STL__INCLUDE__ALGO_HPP
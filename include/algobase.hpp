@@ -5,6 +5,10 @@
  * helper functions for algorithms.
  *
  * @details This file contains the following functions:
+ * - `is_unwrappable_v`: check if two iterators can be unwrapped into native
+ * pointers.
+ * - `is_reverse_memmovable`: check if a copy between two reverse iterators is
+ * a `memmove` of the underlying memory.
  * - `max`: return the larger one of the two given values.
  * - 'min': return the smaller one of the two given values.
  * - `iter_swap`: swap the values of the two given iterators.
@@ -14,6 +18,9 @@
  * given destination.
  * - `copy`: copy a range of elements from the given range to the given
  * destination.
+ * - `stream_copy_bytes`: copy bytes with non-temporal stores.
+ * - `copy_nt`: copy a range of elements without bringing the destination into
+ * the cache.
  * - `unchecked_copy_backward_cat`: copy a range of elements from the given
  * range to the given destination in reverse order.
  * - `unchecked_copy_backward`: copy a range of elements from the given range to
@@ -38,9 +45,13 @@
  * the given destination in reverse order.
  * - `move_backward`: move a range of elements from the given range to the given
  * destination in reverse order.
+ * - `mismatch_bytes`: find the first differing byte of two memory blocks.
  * - `equal`: check if two ranges are equal.
  * - 'fill_cat': fill a range with the given value.
  * - `fill`: fill a range with the given value.
+ * - `all_zero_bytes`: check if all the bytes of the given value are zero.
+ * - `broadcast_fill_bytes`: fill elements of 2, 4, 8 or 16 bytes with vector
+ * stores.
  * - `lexicographical_compare`: check if the first range is lexicographically
  * less than the second range.
  * - `mismatch`: find the first mismatching pair of elements from two ranges.
@@ -48,13 +59,76 @@
 #ifndef TINY_STL__INCLUDE__ALGOBASE_HPP
 #define TINY_STL__INCLUDE__ALGOBASE_HPP
 
+#include <cstdint>
 #include <cstring>
 
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "iterator.hpp"
 #include "utility.hpp"
 
 namespace tiny_stl {
 
+/**
+ * @brief Check if two iterators can be unwrapped into native pointers by
+ * `tiny_stl::to_address`, i.e. both are contiguous and at least one of them is
+ * not a native pointer already.
+ *
+ * @tparam Iter1 The type of the first iterator.
+ * @tparam Iter2 The type of the second iterator.
+ */
+template <class Iter1, class Iter2>
+inline constexpr bool is_unwrappable_v =
+    !(std::is_pointer_v<Iter1> && std::is_pointer_v<Iter2>) &&
+    tiny_stl::is_contiguous_iterator_v<Iter1> &&
+    tiny_stl::is_contiguous_iterator_v<Iter2>;
+
+/**
+ * @brief Check if copying or moving between two iterators is a `memmove` of
+ * the underlying memory in reverse, `false` by default.
+ *
+ * @tparam Iter1 The type of the source iterator.
+ * @tparam Iter2 The type of the destination iterator.
+ */
+template <class Iter1, class Iter2>
+struct is_reverse_memmovable : public tiny_stl::false_type {};
+
+/**
+ * @brief Two reverse iterators over contiguous memory of the same trivially
+ * copyable type, and the destination is writable.
+ *
+ * @tparam Iter1 The type of the base of the source iterator.
+ * @tparam Iter2 The type of the base of the destination iterator.
+ */
+template <class Iter1, class Iter2>
+struct is_reverse_memmovable<tiny_stl::reverse_iterator<Iter1>,
+                             tiny_stl::reverse_iterator<Iter2>>
+    : public tiny_stl::compile_time_constant_bool<
+          tiny_stl::is_contiguous_iterator_v<Iter1> &&
+          tiny_stl::is_contiguous_iterator_v<Iter2> &&
+          std::is_same_v<typename iterator_traits<Iter1>::value_type,
+                         typename iterator_traits<Iter2>::value_type> &&
+          !std::is_const_v<std::remove_reference_t<
+              typename iterator_traits<Iter2>::reference>> &&
+          std::is_trivially_copyable_v<
+              typename iterator_traits<Iter1>::value_type> &&
+          std::is_trivially_copy_constructible_v<
+              typename iterator_traits<Iter1>::value_type> &&
+          std::is_trivially_move_assignable_v<
+              typename iterator_traits<Iter1>::value_type>> {};
+
+/**
+ * @brief Helper variable template of `is_reverse_memmovable`.
+ *
+ * @tparam Iter1 The type of the source iterator.
+ * @tparam Iter2 The type of the destination iterator.
+ */
+template <class Iter1, class Iter2>
+inline constexpr bool is_reverse_memmovable_v =
+    is_reverse_memmovable<Iter1, Iter2>::value;
+
 #ifdef max
 #pragma message("#undefining macro max")
 #undef max
@@ -178,10 +252,40 @@ OutputIter unchecked_copy_cat(RandomAccessIter first, RandomAccessIter last,
   return dest;
 }
 
+/**
+ * @brief Copy a range of elements from the given range to the given
+ * destination, the value is trivially copyable.
+ * @note The type of two given ranges must be the same.
+ * @warning Though the function is called as `memmove`, it is not
+ * "moving" the data, it is actually copying the data.
+ *
+ * @tparam T The type of the given range.
+ * @tparam U The type of the given destination.
+ * @param first The begin iterator of the given range.
+ * @param last The end iterator of the given range.
+ * @param dest The begin iterator of the given destination.
+ * @return U* The end iterator of the given destination.
+ */
+template <class T, class U>
+typename std::enable_if_t<std::is_same_v<typename std::remove_const_t<T>, U> &&
+                              std::is_trivially_copyable_v<U>,
+                          U *>
+unchecked_copy(T *first, T *last, U *dest) {
+  const auto n = static_cast<size_t>(last - first);
+  if (n != 0) {
+    std::memmove(dest, first, n * sizeof(U));
+  }
+
+  return dest + n;
+}
+
 /**
  * @brief Copy a range of elements from the given range to the given
  * destination, the range is specified by the iterators whose tag will
  * be deduced by `tiny_stl::iterator_category`.
+ * @details Contiguous iterators are unwrapped into native pointers, and a pair
+ * of reverse iterators over contiguous memory of a trivially copyable type is
+ * copied by one `memmove` of the underlying memory.
  *
  * @tparam InputIter The type of the given range.
  * @tparam OutputIter The type of the given destination.
@@ -192,15 +296,121 @@ OutputIter unchecked_copy_cat(RandomAccessIter first, RandomAccessIter last,
  */
 template <class InputIter, class OutputIter>
 OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter dest) {
-  unchecked_copy_cat(first, last, dest, tiny_stl::iterator_category(first));
+  if constexpr (tiny_stl::is_unwrappable_v<InputIter, OutputIter>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(first);
+    tiny_stl::unchecked_copy(src, src + n, tiny_stl::to_address(dest));
+    return dest + n;
+  } else if constexpr (tiny_stl::is_reverse_memmovable_v<InputIter,
+                                                         OutputIter>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(last.base());
+    tiny_stl::unchecked_copy(src, src + n,
+                             tiny_stl::to_address(dest.base()) - n);
+    return dest + n;
+  } else {
+    return unchecked_copy_cat(first, last, dest,
+                              tiny_stl::iterator_category(first));
+  }
 }
 
 /**
  * @brief Copy a range of elements from the given range to the given
- * destination, the value is trivially copyable.
- * @note The type of two given ranges must be the same.
- * @warning Though the function is called as `memmove`, it is not
- * "moving" the data, it is actually copying the data.
+ * destination.
+ *
+ * @tparam InputIter The type of the given range.
+ * @tparam OutputIter The type of the given destination.
+ * @param first The begin iterator of the given range.
+ * @param last The end iterator of the given range.
+ * @param dest The begin iterator of the given destination.
+ * @return OutputIter The end iterator of the given destination.
+ */
+template <class InputIter, class OutputIter>
+OutputIter copy(InputIter first, InputIter last, OutputIter dest) {
+  return unchecked_copy(first, last, dest);
+}
+
+/**
+ * @brief The size in bytes from which a copy is considered much larger than the
+ * last level cache, and is done with non-temporal stores.
+ */
+constexpr size_t kStreamingCopyBytes = 32 * 1024 * 1024;
+
+/**
+ * @brief Copy `n` bytes with non-temporal stores, which write to the memory
+ * directly instead of filling the cache with the destination.
+ * @note Without SSE2 (e.g. on non-x86 targets), it is the same as `memcpy`.
+ * @warning The two ranges must not overlap.
+ *
+ * @param dest The destination.
+ * @param src The source.
+ * @param n The number of bytes.
+ */
+inline void stream_copy_bytes(void *dest, const void *src, size_t n) noexcept {
+#if defined(__AVX__) || defined(__SSE2__)
+#if defined(__AVX__)
+  using vec_type = __m256i;
+#else
+  using vec_type = __m128i;
+#endif
+  constexpr size_t kVecBytes = sizeof(vec_type);
+  constexpr size_t kStepBytes = 4 * kVecBytes;
+  auto *d = static_cast<unsigned char *>(dest);
+  auto *s = static_cast<const unsigned char *>(src);
+  // Copy the head with `memcpy`, so the streaming stores are aligned.
+  const size_t head =
+      (kVecBytes - reinterpret_cast<std::uintptr_t>(d) % kVecBytes) % kVecBytes;
+  if (n < head + kStepBytes) {
+    std::memcpy(d, s, n);
+    return;
+  }
+  std::memcpy(d, s, head);
+  d += head;
+  s += head;
+  n -= head;
+  for (; n >= kStepBytes; n -= kStepBytes, d += kStepBytes, s += kStepBytes) {
+    _mm_prefetch(reinterpret_cast<const char *>(s) + 8 * kStepBytes,
+                 _MM_HINT_NTA);
+#if defined(__AVX__)
+    const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    const __m256i v1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 32));
+    const __m256i v2 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 64));
+    const __m256i v3 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + 96));
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 32), v1);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 64), v2);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(d + 96), v3);
+#else
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    const __m128i v1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 16));
+    const __m128i v2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 32));
+    const __m128i v3 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i *>(d), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(d + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(d + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(d + 48), v3);
+#endif
+  }
+  // Non-temporal stores are weakly ordered, make them visible before return.
+  _mm_sfence();
+  std::memcpy(d, s, n);
+#else
+  std::memcpy(dest, src, n);
+#endif
+}
+
+/**
+ * @brief Copy a range of elements with non-temporal stores, the destination is
+ * not brought into the cache.
+ * @note Use it for huge copies whose destination will not be read again soon,
+ * otherwise the copy evicts the whole working set from the cache.
+ * @warning The two ranges must not overlap.
  *
  * @tparam T The type of the given range.
  * @tparam U The type of the given destination.
@@ -211,20 +421,19 @@ OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter dest) {
  */
 template <class T, class U>
 typename std::enable_if_t<std::is_same_v<typename std::remove_const_t<T>, U> &&
-                              std::is_trivially_copy_constructible_v<U>,
+                              std::is_trivially_copyable_v<U>,
                           U *>
-unchecked_copy(T *first, T *last, U *dest) {
+copy_nt(T *first, T *last, U *dest) {
   const auto n = static_cast<size_t>(last - first);
   if (n != 0) {
-    std::memmove(dest, first, n * sizeof(U));
+    tiny_stl::stream_copy_bytes(dest, first, n * sizeof(U));
   }
-
   return dest + n;
 }
 
 /**
- * @brief Copy a range of elements from the given range to the given
- * destination.
+ * @brief Copy a range of elements, the elements can not be streamed so it is
+ * the same as `copy`.
  *
  * @tparam InputIter The type of the given range.
  * @tparam OutputIter The type of the given destination.
@@ -234,8 +443,8 @@ unchecked_copy(T *first, T *last, U *dest) {
  * @return OutputIter The end iterator of the given destination.
  */
 template <class InputIter, class OutputIter>
-OutputIter copy(InputIter first, InputIter last, OutputIter dest) {
-  return unchecked_copy(first, last, dest);
+OutputIter copy_nt(InputIter first, InputIter last, OutputIter dest) {
+  return tiny_stl::copy(first, last, dest);
 }
 
 /**
@@ -284,26 +493,6 @@ unchecked_copy_backward_cat(RandomAccessIter first, RandomAccessIter last,
   return dest;
 }
 
-/**
- * @brief Copy a range of elements from the given range to the given
- * destination in reverse order *backward*, the range is specified by the
- * iterators whose tag will be deduced by `tiny_stl::iterator_category`.
- *
- * @tparam BidirectionalIter1 The type of the given range.
- * @tparam BidirectionalIter2 The type of the given destination.
- * @param first The begin iterator of the given range.
- * @param last The end iterator of the given range.
- * @param dest The end iterator of the given destination.
- * @return BidirectionalIter2 The begin iterator of the given destination.
- */
-template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
-                                           BidirectionalIter1 last,
-                                           BidirectionalIter2 dest) {
-  unchecked_copy_backward_cat(first, last, dest,
-                              tiny_stl::iterator_category(first));
-}
-
 /**
  * @brief Copy a range of elements from the given range to the given
  * destination in reverse order *backward*, the value is trivially copyable.
@@ -331,6 +520,43 @@ unchecked_copy_backward(T *first, T *last, U *dest) {
   return dest;
 }
 
+/**
+ * @brief Copy a range of elements from the given range to the given
+ * destination in reverse order *backward*, the range is specified by the
+ * iterators whose tag will be deduced by `tiny_stl::iterator_category`.
+ * @details Contiguous iterators are unwrapped into native pointers, and a pair
+ * of reverse iterators over contiguous memory of a trivially copyable type is
+ * copied by one `memmove` of the underlying memory.
+ *
+ * @tparam BidirectionalIter1 The type of the given range.
+ * @tparam BidirectionalIter2 The type of the given destination.
+ * @param first The begin iterator of the given range.
+ * @param last The end iterator of the given range.
+ * @param dest The end iterator of the given destination.
+ * @return BidirectionalIter2 The begin iterator of the given destination.
+ */
+template <class BidirectionalIter1, class BidirectionalIter2>
+BidirectionalIter2 unchecked_copy_backward(BidirectionalIter1 first,
+                                           BidirectionalIter1 last,
+                                           BidirectionalIter2 dest) {
+  if constexpr (tiny_stl::is_unwrappable_v<BidirectionalIter1,
+                                           BidirectionalIter2>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(first);
+    tiny_stl::unchecked_copy_backward(src, src + n, tiny_stl::to_address(dest));
+    return dest - n;
+  } else if constexpr (tiny_stl::is_reverse_memmovable_v<BidirectionalIter1,
+                                                         BidirectionalIter2>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(last.base());
+    tiny_stl::unchecked_copy(src, src + n, tiny_stl::to_address(dest.base()));
+    return dest - n;
+  } else {
+    return unchecked_copy_backward_cat(first, last, dest,
+                                       tiny_stl::iterator_category(first));
+  }
+}
+
 /**
  * @brief Copy a range of elements from the given range to the given
  * destination in reverse order *backward*.
@@ -438,7 +664,7 @@ unchecked_copy_n(RandomAccessIter from, Size n, OutputIter to,
 template <class InputIter, class Size, class OutputIter>
 tiny_stl::pair<InputIter, OutputIter> copy_n(InputIter from, Size n,
                                              OutputIter to) {
-  unchecked_copy_n(from, n, to, tiny_stl::iterator_category(from));
+  return unchecked_copy_n(from, n, to, tiny_stl::iterator_category(from));
 }
 
 /**
@@ -486,25 +712,7 @@ OutputIter unchecked_move_cat(RandomAccessIter first, RandomAccessIter last,
 
 /**
  * @brief Move a range of elements from the given range to the given
- * destination, the range is specified by the iterators whose tag will
- * be deduced by `tiny_stl::iterator_category`.
- *
- * @tparam InputIter The type of the given range.
- * @tparam OutputIter The type of the given destination.
- * @param first The begin iterator of the given range.
- * @param last The end iterator of the given range.
- * @param dest The begin iterator of the given destination.
- * @return OutputIter The end iterator of the given destination.
- */
-template <class InputIter, class OutputIer>
-OutputIer unchecked_move(InputIter first, InputIter last, OutputIer dest) {
-  return unchecked_move_cat(first, last, dest,
-                            tiny_stl::iterator_category(first));
-}
-
-/**
- * @brief Move a range of elements from the given range to the given
- * destination, the value is trivially move assignable.
+ * destination, the value is trivially copyable and move assignable.
  * @note The type of two given ranges must be the same.
  *
  * @tparam T The type of the given range.
@@ -516,6 +724,7 @@ OutputIer unchecked_move(InputIter first, InputIter last, OutputIer dest) {
  */
 template <class T, class U>
 typename std::enable_if_t<std::is_same_v<typename std::remove_const_t<T>, U> &&
+                              std::is_trivially_copyable_v<U> &&
                               std::is_trivially_move_assignable_v<T>,
                           U *>
 unchecked_move(T *first, T *last, U *dest) {
@@ -526,6 +735,41 @@ unchecked_move(T *first, T *last, U *dest) {
   return dest + n;
 }
 
+/**
+ * @brief Move a range of elements from the given range to the given
+ * destination, the range is specified by the iterators whose tag will
+ * be deduced by `tiny_stl::iterator_category`.
+ * @details Contiguous iterators are unwrapped into native pointers, and a pair
+ * of reverse iterators over contiguous memory of a trivially copyable type is
+ * moved by one `memmove` of the underlying memory.
+ *
+ * @tparam InputIter The type of the given range.
+ * @tparam OutputIter The type of the given destination.
+ * @param first The begin iterator of the given range.
+ * @param last The end iterator of the given range.
+ * @param dest The begin iterator of the given destination.
+ * @return OutputIter The end iterator of the given destination.
+ */
+template <class InputIter, class OutputIer>
+OutputIer unchecked_move(InputIter first, InputIter last, OutputIer dest) {
+  if constexpr (tiny_stl::is_unwrappable_v<InputIter, OutputIer>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(first);
+    tiny_stl::unchecked_move(src, src + n, tiny_stl::to_address(dest));
+    return dest + n;
+  } else if constexpr (tiny_stl::is_reverse_memmovable_v<InputIter,
+                                                         OutputIer>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(last.base());
+    tiny_stl::unchecked_move(src, src + n,
+                             tiny_stl::to_address(dest.base()) - n);
+    return dest + n;
+  } else {
+    return unchecked_move_cat(first, last, dest,
+                              tiny_stl::iterator_category(first));
+  }
+}
+
 /**
  * @brief Move a range of elements from the given range to the given
  * destination.
@@ -588,26 +832,6 @@ unchecked_move_backward_cat(RandomAccessIter first, RandomAccessIter last,
   return dest;
 }
 
-/**
- * @brief Move a range of elements from the given range to the given
- * destination in reverse order *backward*, the range is specified by the
- * iterators whose tag will be deduced by `tiny_stl::iterator_category`.
- *
- * @tparam BidirectionalIter1 The type of the given range.
- * @tparam BidirectionalIter2 The type of the given destination.
- * @param first The begin iterator of the given range.
- * @param last The end iterator of the given range.
- * @param dest The end iterator of the given destination.
- * @return BidirectionalIter2 The begin iterator of the given destination.
- */
-template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
-                                           BidirectionalIter1 last,
-                                           BidirectionalIter2 dest) {
-  return unchecked_move_backward_cat(first, last, dest,
-                                     tiny_stl::iterator_category(first));
-}
-
 /**
  * @brief Move a range of elements from the given range to the given
  * destination in reverse order *backward*, the value is trivially move
@@ -623,6 +847,7 @@ BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
  */
 template <class T, class U>
 typename std::enable_if_t<std::is_same_v<typename std::remove_const_t<T>, U> &&
+                              std::is_trivially_copyable_v<U> &&
                               std::is_trivially_move_assignable_v<T>,
                           U *>
 unchecked_move_backward(T *first, T *last, U *dest) {
@@ -634,6 +859,43 @@ unchecked_move_backward(T *first, T *last, U *dest) {
   return dest;
 }
 
+/**
+ * @brief Move a range of elements from the given range to the given
+ * destination in reverse order *backward*, the range is specified by the
+ * iterators whose tag will be deduced by `tiny_stl::iterator_category`.
+ * @details Contiguous iterators are unwrapped into native pointers, and a pair
+ * of reverse iterators over contiguous memory of a trivially copyable type is
+ * moved by one `memmove` of the underlying memory.
+ *
+ * @tparam BidirectionalIter1 The type of the given range.
+ * @tparam BidirectionalIter2 The type of the given destination.
+ * @param first The begin iterator of the given range.
+ * @param last The end iterator of the given range.
+ * @param dest The end iterator of the given destination.
+ * @return BidirectionalIter2 The begin iterator of the given destination.
+ */
+template <class BidirectionalIter1, class BidirectionalIter2>
+BidirectionalIter2 unchecked_move_backward(BidirectionalIter1 first,
+                                           BidirectionalIter1 last,
+                                           BidirectionalIter2 dest) {
+  if constexpr (tiny_stl::is_unwrappable_v<BidirectionalIter1,
+                                           BidirectionalIter2>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(first);
+    tiny_stl::unchecked_move_backward(src, src + n, tiny_stl::to_address(dest));
+    return dest - n;
+  } else if constexpr (tiny_stl::is_reverse_memmovable_v<BidirectionalIter1,
+                                                         BidirectionalIter2>) {
+    const auto n = last - first;
+    const auto src = tiny_stl::to_address(last.base());
+    tiny_stl::unchecked_move(src, src + n, tiny_stl::to_address(dest.base()));
+    return dest - n;
+  } else {
+    return unchecked_move_backward_cat(first, last, dest,
+                                       tiny_stl::iterator_category(first));
+  }
+}
+
 /**
  * @brief Move a range of elements from the given range to the given
  * destination in reverse order *backward*.
@@ -674,6 +936,90 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
   return true;
 }
 
+/**
+ * @brief Find the first differing byte of two memory blocks.
+ * @details The blocks are compared one vector register at a time, the equal
+ * lanes are turned into a bit mask by `movemask`, and the first differing lane
+ * is the count of trailing zeros of the inverted mask. Without SSE2 (e.g. on
+ * non-x86 targets), they are compared 8 bytes at a time.
+ *
+ * @param left The first block.
+ * @param right The second block.
+ * @param n The number of bytes of each block.
+ * @return size_t The index of the first differing byte, `n` if the blocks are
+ * equal.
+ */
+inline size_t mismatch_bytes(const void *left, const void *right,
+                             size_t n) noexcept {
+  const auto *a = static_cast<const unsigned char *>(left);
+  const auto *b = static_cast<const unsigned char *>(right);
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 32 <= n; i += 32) {
+    const __m256i va =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    const __m256i vb =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    const auto mask = ~static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= n; i += 16) {
+    const __m128i va =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    const __m128i vb =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    const auto mask =
+        ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) &
+        0xFFFFu;
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t x;
+    std::uint64_t y;
+    std::memcpy(&x, a + i, 8);
+    std::memcpy(&y, b + i, 8);
+    if (x != y) {
+      break;
+    }
+  }
+  for (; i < n; ++i) {
+    if (a[i] != b[i]) {
+      return i;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief Check if two ranges are equal, the value is bitwise comparable (see
+ * `tiny_stl::is_bitwise_comparable`), so the ranges are compared by `memcmp`.
+ *
+ * @tparam T The type of the first range.
+ * @tparam U The type of the second range.
+ * @param first1 The begin iterator of the first range.
+ * @param last1 The end iterator of the first range.
+ * @param first2 The begin iterator of the second range.
+ * @return true If two ranges are equal.
+ * @return false If two ranges are not equal.
+ */
+template <class T, class U>
+typename std::enable_if_t<
+    std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>> &&
+        tiny_stl::is_bitwise_comparable_v<T>,
+    bool>
+equal(T *first1, T *last1, U *first2) {
+  const auto n = static_cast<size_t>(last1 - first1);
+  return n == 0 || std::memcmp(first1, first2, n * sizeof(T)) == 0;
+}
+
 /**
  * @brief Check if two ranges are equal, the value is trivially
  * comparable.
@@ -699,25 +1045,6 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 dest2,
   return true;
 }
 
-/**
- * @brief Fill a range with the given value, the range is specified by
- * the iterators of tag `tiny_stl::input_iterator_tag`.
- *
- * @tparam InputIter The type of the given range.
- * @tparam T The type of the given value.
- * @param first The begin iterator of the given range.
- * @param last The end iterator of the given range.
- * @param value The given value.
- */
-template <class OutputIter, class Size, class T>
-OutputIter unchecked_fill_n(OutputIter first, Size n, const T &value) {
-  for (; n > 0; --n) {
-    *(first++) = value;
-  }
-
-  return first;
-}
-
 /**
  * @brief Fill a range with the given value, the value is trivially
  * copyable.
@@ -741,6 +1068,191 @@ unchecked_fill_n(T *first, Size n, U value) {
   return first + n;
 }
 
+/**
+ * @brief Check if all the bytes of the given value are zero.
+ * @note Always `false` if `T` is not zero-initializable, in which case an
+ * all-zero object may not be valid (see `tiny_stl::is_zero_initializable`).
+ *
+ * @tparam T The type of the given value.
+ * @param value The given value.
+ * @return true If the value can be produced by zeroing its memory.
+ * @return false If the value can not be produced by zeroing its memory.
+ */
+template <class T> bool all_zero_bytes(const T &value) {
+  if constexpr (tiny_stl::is_zero_initializable_v<T>) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      if (bytes[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**
+ * @brief Fill `n` elements of `Width` bytes with the given pattern, by
+ * broadcasting the pattern into a vector register and storing it repeatedly.
+ * @note `Width` must be 2, 4, 8 or 16. Without SSE2 (e.g. on non-x86 targets),
+ * the elements are copied one by one.
+ *
+ * @tparam Width The size of an element.
+ * @param dest The destination.
+ * @param pattern The bytes of one element.
+ * @param n The number of elements.
+ */
+template <size_t Width>
+void broadcast_fill_bytes(void *dest, const void *pattern, size_t n) noexcept {
+  static_assert(Width == 2 || Width == 4 || Width == 8 || Width == 16,
+                "the width of the pattern must divide the vector width");
+  auto *d = static_cast<unsigned char *>(dest);
+  const size_t bytes = n * Width;
+#if defined(__AVX__) || defined(__SSE2__)
+#if defined(__AVX__)
+  using vec_type = __m256i;
+#else
+  using vec_type = __m128i;
+#endif
+  constexpr size_t kVecBytes = sizeof(vec_type);
+  if (bytes >= kVecBytes) {
+    // The vector holds the pattern `kVecBytes / Width` times.
+    unsigned char buf[kVecBytes];
+    for (size_t i = 0; i < kVecBytes; i += Width) {
+      std::memcpy(buf + i, pattern, Width);
+    }
+    vec_type vec;
+    std::memcpy(&vec, buf, kVecBytes);
+    size_t i = 0;
+    for (; i + 4 * kVecBytes <= bytes; i += 4 * kVecBytes) {
+#if defined(__AVX__)
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), vec);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 32), vec);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 64), vec);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i + 96), vec);
+#else
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), vec);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i + 16), vec);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i + 32), vec);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i + 48), vec);
+#endif
+    }
+    for (; i + kVecBytes <= bytes; i += kVecBytes) {
+      std::memcpy(d + i, &vec, kVecBytes);
+    }
+    // The tail is covered by one store overlapping the previous ones, it
+    // starts at a multiple of `Width` so the pattern stays in phase.
+    if (i != bytes) {
+      std::memcpy(d + bytes - kVecBytes, &vec, kVecBytes);
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < bytes; i += Width) {
+    std::memcpy(d + i, pattern, Width);
+  }
+}
+
+/**
+ * @brief Check if a range of `T` can be filled by copying the bytes of the
+ * value, i.e. `T` is zero-initializable, or it is a trivially copyable type of
+ * a vector-friendly width. One-byte integers are excluded, they are filled by
+ * `memset` directly.
+ *
+ * @tparam T The type of the elements.
+ * @tparam U The type of the value.
+ */
+template <class T, class U>
+inline constexpr bool is_bytewise_fillable_v =
+    !std::is_const_v<T> &&
+    !(std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool> &&
+      std::is_integral_v<U> && sizeof(U) == 1) &&
+    (tiny_stl::is_zero_initializable_v<T> ||
+     (std::is_trivially_copyable_v<T> &&
+      std::is_trivially_copy_assignable_v<T> &&
+      std::is_same_v<std::remove_cv_t<U>, T> &&
+      (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 ||
+       sizeof(T) == 16)));
+
+/**
+ * @brief Fill a range with the given value, the value type is
+ * zero-initializable or trivially copyable, and wider than one byte.
+ * @details If all the bytes of a zero-initializable value are zero, the range
+ * will be filled by one `memset`. Otherwise elements of 2, 4, 8 or 16 bytes are
+ * filled by `broadcast_fill_bytes`, and the others element by element.
+ *
+ * @tparam T The type of the given range.
+ * @tparam Size The type of the given size.
+ * @tparam U The type of the given value.
+ * @param first The begin iterator of the given range.
+ * @param n The size of the given range.
+ * @param value The given value.
+ * @return T* The end iterator of the given range.
+ */
+template <class T, class Size, class U>
+typename std::enable_if_t<tiny_stl::is_bytewise_fillable_v<T, U>, T *>
+unchecked_fill_n(T *first, Size n, const U &value) {
+  if (n <= 0) {
+    return first;
+  }
+  const T tmp = value;
+  if (tiny_stl::all_zero_bytes(tmp)) {
+    std::memset(first, 0, static_cast<size_t>(n) * sizeof(T));
+    return first + n;
+  }
+  if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 ||
+                sizeof(T) == 16) {
+    tiny_stl::broadcast_fill_bytes<sizeof(T)>(first, &tmp,
+                                              static_cast<size_t>(n));
+    return first + n;
+  } else {
+    for (; n > 0; --n) {
+      *(first++) = tmp;
+    }
+    return first;
+  }
+}
+
+/**
+ * @brief Fill a range with the given value.
+ * @details A contiguous iterator is unwrapped into a native pointer, and a
+ * reverse iterator over contiguous memory fills the underlying memory, so
+ * both of them reach the fast paths of native pointers.
+ *
+ * @tparam OutputIter The type of the given range.
+ * @tparam Size The type of the given size.
+ * @tparam T The type of the given value.
+ * @param first The begin iterator of the given range.
+ * @param n The size of the given range.
+ * @param value The given value.
+ * @return OutputIter The end iterator of the given range.
+ */
+template <class OutputIter, class Size, class T>
+OutputIter unchecked_fill_n(OutputIter first, Size n, const T &value) {
+  if constexpr (tiny_stl::is_unwrappable_v<OutputIter, OutputIter>) {
+    if (n > 0) {
+      tiny_stl::unchecked_fill_n(tiny_stl::to_address(first), n, value);
+      return first + n;
+    }
+    return first;
+  } else if constexpr (tiny_stl::is_reverse_iterator<OutputIter>::value &&
+                       tiny_stl::is_contiguous_iterator_v<
+                           typename OutputIter::iterator_type>) {
+    if (n > 0) {
+      tiny_stl::unchecked_fill_n(tiny_stl::to_address(first.base()) - n, n,
+                                 value);
+      return first + n;
+    }
+    return first;
+  } else {
+    for (; n > 0; --n) {
+      *(first++) = value;
+    }
+    return first;
+  }
+}
+
 /**
  * @brief Fill a range with the given value.
  *
@@ -897,16 +1409,58 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
  * @return false If the first range is not lexicographically less than the
  * second range.
  */
-bool lexicographical_compare(const unsigned char *first1,
-                             const unsigned char *last1,
-                             const unsigned char *first2,
-                             const unsigned char *last2) {
+inline bool lexicographical_compare(const unsigned char *first1,
+                                    const unsigned char *last1,
+                                    const unsigned char *first2,
+                                    const unsigned char *last2) {
   const auto len1 = last1 - first1;
   const auto len2 = last2 - first2;
   const auto result = std::memcmp(first1, first2, tiny_stl::min(len1, len2));
   return result != 0 ? result < 0 : len1 < len2;
 }
 
+/**
+ * @brief Check if the first range is lexicographically less than the
+ * second range, the value is bitwise comparable.
+ * @details The first mismatching pair of elements is found by
+ * `mismatch_bytes`, and then only that pair is compared by `operator<`.
+ *
+ * @tparam T The type of the first range.
+ * @tparam U The type of the second range.
+ * @param first1 The begin iterator of the first range.
+ * @param last1 The end iterator of the first range.
+ * @param first2 The begin iterator of the second range.
+ * @param last2 The end iterator of the second range.
+ * @return true If the first range is lexicographically less than the second
+ * range.
+ * @return false If the first range is not lexicographically less than the
+ * second range.
+ */
+template <class T, class U>
+typename std::enable_if_t<
+    std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>> &&
+        tiny_stl::is_bitwise_comparable_v<T>,
+    bool>
+lexicographical_compare(T *first1, T *last1, U *first2, U *last2) {
+  const auto len1 = static_cast<size_t>(last1 - first1);
+  const auto len2 = static_cast<size_t>(last2 - first2);
+  const auto len = tiny_stl::min(len1, len2);
+  const auto i =
+      tiny_stl::mismatch_bytes(first1, first2, len * sizeof(T)) / sizeof(T);
+  return i != len ? first1[i] < first2[i] : len1 < len2;
+}
+
+/**
+ * @brief Find the first mismatching pair of elements from two ranges.
+ *
+ * @tparam InputIter1 The type of the first range.
+ * @tparam InputIter2 The type of the second range.
+ * @param first1 The begin iterator of the first range.
+ * @param last1 The end iterator of the first range.
+ * @param first2 The begin iterator of the second range.
+ * @return tiny_stl::pair<InputIter1, InputIter2> The iterators to the first
+ * mismatching pair, `last1` and its counterpart if the ranges are equal.
+ */
 template <class InputIter1, class InputIter2>
 tiny_stl::pair<InputIter1, InputIter2>
 mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
@@ -917,6 +1471,30 @@ mismatch(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
   return tiny_stl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+/**
+ * @brief Find the first mismatching pair of elements from two ranges, the
+ * value is bitwise comparable, so the ranges are compared by `mismatch_bytes`.
+ *
+ * @tparam T The type of the first range.
+ * @tparam U The type of the second range.
+ * @param first1 The begin iterator of the first range.
+ * @param last1 The end iterator of the first range.
+ * @param first2 The begin iterator of the second range.
+ * @return tiny_stl::pair<T *, U *> The iterators to the first mismatching pair,
+ * `last1` and its counterpart if the ranges are equal.
+ */
+template <class T, class U>
+typename std::enable_if_t<
+    std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>> &&
+        tiny_stl::is_bitwise_comparable_v<T>,
+    tiny_stl::pair<T *, U *>>
+mismatch(T *first1, T *last1, U *first2) {
+  const auto n = static_cast<size_t>(last1 - first1);
+  const auto i = tiny_stl::mismatch_bytes(first1, first2, n * sizeof(T)) /
+                 sizeof(T);
+  return tiny_stl::pair<T *, U *>(first1 + i, first2 + i);
+}
+
 } // namespace tiny_stl
 
 #endif // ! TINY_STL__INCLUDE__ALGOBASE_HPP
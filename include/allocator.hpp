@@ -10,6 +10,9 @@
 #ifndef TINY_STL__INCLUDE__ALLOCATOR_HPP
 #define TINY_STL__INCLUDE__ALLOCATOR_HPP
 
+#include <cstdlib>
+#include <new>
+
 #include "construct.hpp"
 #include "utility.hpp"
 
@@ -44,6 +47,17 @@ public:
    * @return T* The pointer to the allocated memory.
    */
   static T *allocate(size_type n);
+  /**
+   * @brief Allocate memory for n objects of type T, all the bytes of which
+   * are zero.
+   * @note The memory comes from `calloc`, large blocks of which are fresh
+   * pages mapped by the system, so they are zero without being written. It
+   * must be released by `deallocate_zeroed`, not by `deallocate`.
+   *
+   * @param n The number of objects to be allocated.
+   * @return T* The pointer to the allocated memory.
+   */
+  static T *allocate_zeroed(size_type n);
 
   /**
    * @brief Deallocate memory for an object of type T.
@@ -58,6 +72,14 @@ public:
    * @param n The number of objects to be deallocated.
    */
   static void deallocate(T *ptr, size_type n);
+  /**
+   * @brief Deallocate memory for n objects of type T, which was allocated by
+   * `allocate_zeroed`.
+   *
+   * @param ptr The pointer to the memory to be deallocated.
+   * @param n The number of objects to be deallocated.
+   */
+  static void deallocate_zeroed(T *ptr, size_type n);
 
   /**
    * @brief Construct an object of type T.
@@ -105,15 +127,28 @@ public:
 };
 
 template <class T> T *allocator<T>::allocate() {
-  return static_cast<T *>(::operator new(sizeof(T)));
+  return allocate(1);
 }
 
 template <class T> T *allocator<T>::allocate(size_type n) {
   if (n == 0)
     return nullptr;
+  if (n > static_cast<size_type>(-1) / sizeof(T))
+    throw std::bad_alloc();
   return static_cast<T *>(::operator new(n * sizeof(T)));
 }
 
+template <class T> T *allocator<T>::allocate_zeroed(size_type n) {
+  if (n == 0)
+    return nullptr;
+  if (n > static_cast<size_type>(-1) / sizeof(T))
+    throw std::bad_alloc();
+  auto ptr = static_cast<T *>(std::calloc(n, sizeof(T)));
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
 template <class T> void allocator<T>::deallocate(T *ptr) {
   if (ptr == nullptr)
     return;
@@ -126,6 +161,11 @@ template <class T> void allocator<T>::deallocate(T *ptr, size_type /*size*/) {
   ::operator delete(ptr);
 }
 
+template <class T>
+void allocator<T>::deallocate_zeroed(T *ptr, size_type /*size*/) {
+  std::free(ptr);
+}
+
 template <class T> void allocator<T>::construct(T *ptr) { construct(ptr); }
 
 template <class T> void allocator<T>::construct(T *ptr, const T &value) {
@@ -47,7 +47,7 @@ template <class T> void construct(T *ptr, const T &val) {
  * @param ptr The address of the object to be constructed.
  * @param args The parameters to be passed to the constructor.
  */
-template <class T, class... Args> void construct(T *ptr, Args... args) {
+template <class T, class... Args> void construct(T *ptr, Args &&...args) {
   ::new ((void *)ptr) T(tiny_stl::forward<Args>(args)...);
 }
 
@@ -0,0 +1,560 @@
+/**
+ * @file execution.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains the execution policies and the worker pool used
+ * by the parallel algorithms.
+ *
+ * @details This file contains the following utilities:
+ * - `sequenced_policy`, `seq`: run an algorithm on the calling thread.
+ * - `parallel_policy`, `par`: allow an algorithm to run on the worker pool.
+ * - `is_execution_policy`: check if a type is an execution policy.
+ * - `thread_pool`: a pool of worker threads balanced by work stealing.
+ * - `default_thread_pool`: the pool shared by the parallel algorithms.
+ * - `set_default_thread_count`: replace the shared pool by one of another size.
+ * - `task_group`: a group of tasks which can be waited for together.
+ * - `parallel_chunk_count`: the number of chunks a range should be split into.
+ * - `parallel_for`: run a function on every chunk index in parallel.
+ * - `parallel_for_nothrow`: the same as `parallel_for`, and every call is made
+ * even if the pool fails.
+ */
+#ifndef TINY_STL__INCLUDE__EXECUTION_HPP
+#define TINY_STL__INCLUDE__EXECUTION_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "type_traits.hpp"
+
+namespace tiny_stl {
+
+/**
+ * @brief Execution policy, the algorithm runs on the calling thread.
+ */
+struct sequenced_policy {};
+
+/**
+ * @brief Execution policy, the algorithm may split its work across the worker
+ * pool.
+ */
+struct parallel_policy {};
+
+/**
+ * @brief The instance of `sequenced_policy`.
+ */
+inline constexpr sequenced_policy seq{};
+
+/**
+ * @brief The instance of `parallel_policy`.
+ */
+inline constexpr parallel_policy par{};
+
+/**
+ * @brief Check if `T` is an execution policy, `false` by default.
+ *
+ * @tparam T The type to be checked.
+ */
+template <class T> struct is_execution_policy : tiny_stl::false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : tiny_stl::true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy> : tiny_stl::true_type {};
+
+/**
+ * @brief Helper variable template of `is_execution_policy`, cv-qualifiers and
+ * references are ignored.
+ *
+ * @tparam T The type to be checked.
+ */
+template <class T>
+inline constexpr bool is_execution_policy_v =
+    is_execution_policy<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
+/**
+ * @brief The minimum number of bytes handled by one chunk of a parallel
+ * algorithm, smaller ranges are not worth waking a worker for.
+ */
+constexpr size_t kParallelGrainBytes = 256 * 1024;
+
+/**
+ * @brief A pool of worker threads balancing the tasks by work stealing.
+ *
+ * @details Every worker owns a deque of tasks, and the threads outside the pool
+ * share one more deque. A task submitted by a worker is pushed to its own
+ * deque, which the worker pops from the back (the most recent task, whose data
+ * is still in the cache). An idle worker steals from the front of the other
+ * deques (the oldest task, which is usually the largest piece of work).
+ */
+class thread_pool {
+public:
+  using task_type = std::function<void()>;
+
+private:
+  /**
+   * @brief The deque of tasks owned by a worker.
+   */
+  struct task_queue {
+    std::mutex mutex;            // The lock guarding `tasks`.
+    std::deque<task_type> tasks; // The tasks waiting to run.
+  };
+
+  /**
+   * @brief The identity of the calling thread.
+   */
+  struct worker_identity {
+    const thread_pool *pool = nullptr; // The pool owning the thread, if any.
+    size_t index = 0;                  // The index of its worker.
+  };
+
+  std::thread *workers;         // The worker threads.
+  size_t worker_count;          // The number of worker threads.
+  task_queue *queues;           // The deques, and the one for outside threads.
+  std::mutex mutex;             // The lock guarding `queued` and `stopping`.
+  std::condition_variable cond; // Notified when a task is submitted.
+  size_t queued;                // The number of tasks in all the deques.
+  bool stopping;                // Set when the pool is destroyed.
+
+public:
+  /**
+   * @brief Construct a new thread pool object.
+   *
+   * @param n The number of worker threads, `0` is allowed, in which case the
+   * tasks are run by the threads waiting for them.
+   */
+  explicit thread_pool(size_t n)
+      : workers(nullptr), worker_count(n), queues(nullptr), queued(0),
+        stopping(false) {
+    queues = new task_queue[n + 1];
+    try {
+      workers = new std::thread[n];
+      for (size_t i = 0; i < n; ++i) {
+        workers[i] = std::thread([this, i] { worker_loop(i); });
+      }
+    } catch (...) {
+      shutdown();
+      throw;
+    }
+  }
+
+  /**
+   * @brief Destroy the thread pool object.
+   * @note The tasks already submitted are finished before the workers exit.
+   */
+  ~thread_pool() { shutdown(); }
+
+public:
+  /**
+   * @brief Get the number of worker threads.
+   *
+   * @return size_t The number of worker threads.
+   */
+  size_t size() const noexcept { return worker_count; }
+
+  /**
+   * @brief Submit a task to the pool.
+   * @note A worker pushes to its own deque, other threads to the shared one.
+   *
+   * @param task The task to be run by one of the workers.
+   */
+  void submit(task_type task) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      ++queued;
+    }
+    task_queue &queue = queues[own_index()];
+    try {
+      std::lock_guard<std::mutex> guard(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(mutex);
+      --queued;
+      throw;
+    }
+    cond.notify_one();
+  }
+
+  /**
+   * @brief Run one waiting task on the calling thread, if there is one.
+   * @note Threads waiting for their tasks call this to help instead of
+   * blocking, so nested parallel algorithms can not dead lock the pool.
+   *
+   * @return true If a task was run.
+   * @return false If no task was waiting.
+   */
+  bool try_run_one() {
+    task_type task;
+    if (!take(own_index(), task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+private:
+  /**
+   * @brief Get the identity of the calling thread.
+   *
+   * @return worker_identity& The identity.
+   */
+  static worker_identity &identity() noexcept {
+    static thread_local worker_identity id;
+    return id;
+  }
+
+  /**
+   * @brief Get the index of the deque of the calling thread.
+   *
+   * @return size_t The index of its worker, or `worker_count` for the threads
+   * outside the pool.
+   */
+  size_t own_index() const noexcept {
+    const worker_identity &id = identity();
+    return id.pool == this ? id.index : worker_count;
+  }
+
+  /**
+   * @brief Take a task, from the back of the own deque first, then from the
+   * front of the others.
+   *
+   * @param index The index of the own deque.
+   * @param task The task taken.
+   * @return true If a task was taken.
+   * @return false If all the deques are empty.
+   */
+  bool take(size_t index, task_type &task) {
+    const size_t queue_count = worker_count + 1;
+    for (size_t i = 0; i < queue_count; ++i) {
+      task_queue &queue = queues[(index + i) % queue_count];
+      std::lock_guard<std::mutex> guard(queue.mutex);
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      std::lock_guard<std::mutex> count_guard(mutex);
+      --queued;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief The loop of a worker thread.
+   *
+   * @param index The index of the worker.
+   */
+  void worker_loop(size_t index) {
+    identity().pool = this;
+    identity().index = index;
+    task_type task;
+    while (true) {
+      if (take(index, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [this] { return stopping || queued != 0; });
+      if (stopping && queued == 0) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Stop and join all the workers.
+   */
+  void shutdown() noexcept {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    for (size_t i = 0; workers && i < worker_count; ++i) {
+      if (workers[i].joinable()) {
+        workers[i].join();
+      }
+    }
+    delete[] workers;
+    delete[] queues;
+    workers = nullptr;
+    queues = nullptr;
+  }
+
+private:
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+};
+
+/**
+ * @brief Get the slot holding the pool shared by the parallel algorithms.
+ * @note The pool has one worker less than the hardware threads, since the
+ * thread calling a parallel algorithm takes a share of the work as well.
+ *
+ * @return std::unique_ptr<thread_pool>& The slot.
+ */
+inline std::unique_ptr<thread_pool> &default_thread_pool_slot() {
+  static std::unique_ptr<thread_pool> pool(
+      new thread_pool(std::thread::hardware_concurrency() > 1
+                          ? std::thread::hardware_concurrency() - 1
+                          : 1));
+  return pool;
+}
+
+/**
+ * @brief Get the pool shared by the parallel algorithms.
+ *
+ * @return thread_pool& The pool.
+ */
+inline thread_pool &default_thread_pool() {
+  return *tiny_stl::default_thread_pool_slot();
+}
+
+/**
+ * @brief Replace the pool shared by the parallel algorithms, so that they use
+ * `n` threads including the calling one.
+ * @warning No parallel algorithm may be running when it is called.
+ *
+ * @param n The number of threads, `1` makes the parallel algorithms run
+ * sequentially.
+ */
+inline void set_default_thread_count(size_t n) {
+  auto &slot = tiny_stl::default_thread_pool_slot();
+  slot.reset();
+  slot.reset(new thread_pool(n > 1 ? n - 1 : 0));
+}
+
+/**
+ * @brief A group of tasks submitted to a pool, which can be waited for
+ * together.
+ * @details The first exception thrown by a task is kept, and it is rethrown by
+ * `wait` after all the tasks are finished.
+ */
+class task_group {
+private:
+  thread_pool &pool;            // The pool running the tasks.
+  size_t pending;               // The number of tasks not finished yet.
+  std::exception_ptr error;     // The first exception thrown by a task.
+  std::mutex mutex;             // The lock guarding `pending` and `error`.
+  std::condition_variable cond; // Notified when a task is finished.
+
+public:
+  /**
+   * @brief Construct a new task group object.
+   *
+   * @param p The pool running the tasks.
+   */
+  explicit task_group(thread_pool &p = tiny_stl::default_thread_pool())
+      : pool(p), pending(0) {}
+
+  /**
+   * @brief Destroy the task group object, after all the tasks are finished.
+   */
+  ~task_group() { wait_all(); }
+
+public:
+  /**
+   * @brief Submit a task to the pool.
+   *
+   * @tparam Function The type of the task.
+   * @param func The task.
+   */
+  template <class Function> void run(Function func) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      ++pending;
+    }
+    try {
+      submit(func);
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(mutex);
+      --pending;
+      throw;
+    }
+  }
+
+  /**
+   * @brief Wait for all the tasks, and rethrow the first exception thrown by
+   * them.
+   */
+  void wait() {
+    wait_all();
+    std::exception_ptr result;
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      result = error;
+      error = nullptr;
+    }
+    if (result) {
+      std::rethrow_exception(result);
+    }
+  }
+
+private:
+  /**
+   * @brief Wrap the task to record its exception and its completion, and
+   * submit it to the pool.
+   *
+   * @tparam Function The type of the task.
+   * @param func The task.
+   */
+  template <class Function> void submit(Function &func) {
+    pool.submit([this, func]() mutable {
+      try {
+        func();
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      std::lock_guard<std::mutex> guard(mutex);
+      if (--pending == 0) {
+        cond.notify_all();
+      }
+    });
+  }
+
+  /**
+   * @brief Wait for all the tasks, running the waiting tasks of the pool in
+   * the meantime.
+   */
+  void wait_all() noexcept {
+    while (true) {
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (pending == 0) {
+          return;
+        }
+      }
+      if (!pool.try_run_one()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return pending == 0; });
+        return;
+      }
+    }
+  }
+
+private:
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+};
+
+/**
+ * @brief Get the number of chunks a range should be split into.
+ *
+ * @param n The number of elements of the range.
+ * @param grain The minimum number of elements of a chunk.
+ * @return size_t The number of chunks, no more than the workers of the
+ * default pool plus the calling thread.
+ */
+inline size_t parallel_chunk_count(size_t n, size_t grain) {
+  if (grain == 0) {
+    grain = 1;
+  }
+  const size_t max_chunks = tiny_stl::default_thread_pool().size() + 1;
+  const size_t chunks = n / grain;
+  if (chunks == 0) {
+    return 1;
+  }
+  return chunks < max_chunks ? chunks : max_chunks;
+}
+
+/**
+ * @brief Run `func(i)` for every `i` in `[0, n)` in parallel.
+ * @details Chunk `0` runs on the calling thread, the others are submitted to
+ * the default pool. All the calls are finished before the function returns,
+ * even if some of them throw, and then the first exception is rethrown.
+ *
+ * @tparam Function The type of the function.
+ * @param n The number of calls.
+ * @param func The function, called with the index of the chunk.
+ */
+template <class Function> void parallel_for(size_t n, Function func) {
+  if (n == 0) {
+    return;
+  }
+  if (n == 1) {
+    func(static_cast<size_t>(0));
+    return;
+  }
+  task_group group;
+  for (size_t i = 1; i < n; ++i) {
+    group.run([&func, i] { func(i); });
+  }
+  std::exception_ptr error;
+  try {
+    func(static_cast<size_t>(0));
+  } catch (...) {
+    error = std::current_exception();
+  }
+  try {
+    group.wait();
+  } catch (...) {
+    if (!error) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Run `func(i)` for every `i` in `[0, n)` in parallel, `func` must not
+ * throw.
+ * @details Every call is made exactly once even if the tasks can not be
+ * submitted to the pool (e.g. out of memory), in which case the remaining
+ * calls are made on the calling thread. It suits the steps which must not be
+ * left half done, like moving elements to a buffer and back.
+ *
+ * @tparam Function The type of the function.
+ * @param n The number of calls.
+ * @param func The function, called with the index of the chunk.
+ */
+template <class Function> void parallel_for_nothrow(size_t n, Function func) {
+  std::unique_ptr<bool[]> done;
+  try {
+    done.reset(new bool[n]());
+    tiny_stl::parallel_for(n, [&func, &done](size_t i) {
+      func(i);
+      done[i] = true;
+    });
+  } catch (...) {
+    for (size_t i = 0; i < n; ++i) {
+      if (!done || !done[i]) {
+        func(i);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Get the first index of the `i`-th chunk, when `n` elements are split
+ * into `chunks` chunks of nearly equal size.
+ *
+ * @param n The number of elements.
+ * @param chunks The number of chunks.
+ * @param i The index of the chunk, `i == chunks` gives `n`.
+ * @return size_t The first index of the chunk.
+ */
+inline size_t chunk_begin(size_t n, size_t chunks, size_t i) {
+  return n / chunks * i + (i < n % chunks ? i : n % chunks);
+}
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__EXECUTION_HPP
@@ -0,0 +1,556 @@
+/**
+ * @file external_sort.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains a sort for data larger than the memory.
+ *
+ * @details The records are sorted a memory load at a time into runs, which are
+ * spilled to temporary files, and the runs are then merged in one pass by a
+ * loser tree. Every file is read and written in large sequential blocks, and
+ * every read and write is double-buffered: the next block is transferred by a
+ * task of the default thread pool while the current one is used. This file
+ * contains the following utilities:
+ * - `external_file`: a C file closed on destruction, with reads and writes
+ * throwing on errors.
+ * - `external_block_reader`: the records of a file, read a block ahead.
+ * - `external_block_writer`: records appended to a file, written a block
+ * behind.
+ * - `external_sort`: sort an input range into an output iterator.
+ * - `external_sort_file`: sort a binary file of records into another.
+ */
+#ifndef TINY_STL__INCLUDE__EXTERNAL_SORT_HPP
+#define TINY_STL__INCLUDE__EXTERNAL_SORT_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "algo.hpp"
+#include "exception.hpp"
+#include "execution.hpp"
+#include "functional.hpp"
+#include "loser_tree.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace tiny_stl {
+
+/**
+ * @brief A C file, closed when the object is destroyed.
+ */
+class external_file {
+private:
+  std::FILE *file; // The file.
+
+public:
+  /**
+   * @brief Take the ownership of an open file.
+   *
+   * @param f The file, a null pointer means it could not be opened.
+   * @throw std::runtime_error The file could not be opened.
+   */
+  explicit external_file(std::FILE *f) : file(f) {
+    THROW_RUNTIME_ERROR_IF(file == nullptr, "external_file: cannot open file");
+  }
+
+  /**
+   * @brief Open a file by its path.
+   *
+   * @param path The path.
+   * @param mode The mode, as for `std::fopen`.
+   * @throw std::runtime_error The file could not be opened.
+   */
+  external_file(const char *path, const char *mode)
+      : external_file(std::fopen(path, mode)) {}
+
+  /**
+   * @brief Create an anonymous temporary file, removed when closed.
+   * @details The file is created in `dir`, or in the directory named by the
+   * `TMPDIR` environment variable when `dir` is null. Without either, it is
+   * created by `std::tmpfile`, which uses the system temporary directory.
+   * @note The directory is only honoured on POSIX systems, the others always
+   * use `std::tmpfile`.
+   *
+   * @param dir The directory, may be null.
+   * @return external_file The file.
+   * @throw std::runtime_error The file could not be created.
+   */
+  static external_file temporary(const char *dir = nullptr) {
+    if (dir == nullptr || *dir == '\0') {
+      dir = std::getenv("TMPDIR");
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (dir != nullptr && *dir != '\0') {
+      std::string path = dir;
+      path += "/tiny_stl_run_XXXXXX";
+      const int fd = ::mkstemp(&path[0]);
+      THROW_RUNTIME_ERROR_IF(fd < 0, "external_file: cannot create file");
+      // Removed from the directory at once, the data lives until closed.
+      ::unlink(path.c_str());
+      std::FILE *f = ::fdopen(fd, "w+b");
+      if (f == nullptr) {
+        ::close(fd);
+      }
+      return external_file(f);
+    }
+#endif
+    return external_file(std::tmpfile());
+  }
+
+  external_file(external_file &&other) noexcept : file(other.file) {
+    other.file = nullptr;
+  }
+
+  ~external_file() {
+    if (file) {
+      std::fclose(file);
+    }
+  }
+
+  external_file(const external_file &) = delete;
+  external_file &operator=(const external_file &) = delete;
+  external_file &operator=(external_file &&) = delete;
+
+public:
+  /**
+   * @brief Read some records.
+   *
+   * @tparam T The type of the records.
+   * @param data Where the records are read to.
+   * @param n The maximum number of records.
+   * @return std::size_t The number of records read, less than `n` only at the
+   * end of the file.
+   * @throw std::runtime_error The file could not be read, or ends in the
+   * middle of a record.
+   */
+  template <class T> std::size_t read(T *data, std::size_t n) {
+    const std::size_t bytes = std::fread(data, 1, n * sizeof(T), file);
+    THROW_RUNTIME_ERROR_IF(std::ferror(file),
+                           "external_file: cannot read file");
+    THROW_RUNTIME_ERROR_IF(bytes % sizeof(T) != 0,
+                           "external_file: file ends in a record");
+    return bytes / sizeof(T);
+  }
+
+  /**
+   * @brief Write some records.
+   *
+   * @tparam T The type of the records.
+   * @param data The records.
+   * @param n The number of records.
+   * @throw std::runtime_error The file could not be written.
+   */
+  template <class T> void write(const T *data, std::size_t n) {
+    THROW_RUNTIME_ERROR_IF(std::fwrite(data, sizeof(T), n, file) != n,
+                           "external_file: cannot write file");
+  }
+
+  /**
+   * @brief Write the buffered data and go back to the beginning.
+   *
+   * @throw std::runtime_error The file could not be written.
+   */
+  void rewind() {
+    THROW_RUNTIME_ERROR_IF(std::fflush(file) != 0,
+                           "external_file: cannot write file");
+    std::rewind(file);
+  }
+
+  /**
+   * @brief Write the buffered data.
+   *
+   * @throw std::runtime_error The file could not be written.
+   */
+  void flush() {
+    THROW_RUNTIME_ERROR_IF(std::fflush(file) != 0,
+                           "external_file: cannot write file");
+  }
+};
+
+/**
+ * @brief The records of a file from its current position on, read a block at
+ * a time, the next block being read by a task while the current one is used.
+ *
+ * @tparam T The type of the records, which must be trivially copyable.
+ */
+template <class T> class external_block_reader {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_block_reader needs trivially copyable records");
+
+private:
+  external_file &file;
+  tiny_stl::vector<T> front;
+  tiny_stl::vector<T> back;
+  std::size_t front_size = 0;
+  std::size_t back_size = 0;
+  std::size_t pos = 0;
+  // The read of `back`, declared last to be waited for first.
+  task_group pending;
+
+  void read_back() {
+    pending.run([this] { back_size = file.read(back.data(), back.size()); });
+  }
+
+public:
+  /**
+   * @brief The iterator over the records left, an input iterator.
+   * @note Only the comparison with the end is meaningful: an iterator equals
+   * the end once the records are exhausted.
+   */
+  class iterator {
+  private:
+    external_block_reader *reader = nullptr;
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    iterator() = default;
+    explicit iterator(external_block_reader *r) : reader(r) {}
+
+    reference operator*() const { return reader->front[reader->pos]; }
+    pointer operator->() const { return &**this; }
+
+    iterator &operator++() {
+      reader->next();
+      return *this;
+    }
+
+    bool operator==(const iterator &other) const {
+      return at_end() == other.at_end();
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    bool at_end() const { return reader == nullptr || reader->empty(); }
+  };
+
+public:
+  /**
+   * @brief Start reading a file.
+   *
+   * @param f The file, read from its current position.
+   * @param block The number of records of a read, at least 1.
+   * @throw std::runtime_error The file could not be read.
+   */
+  external_block_reader(external_file &f, std::size_t block)
+      : file(f), front(block > 0 ? block : 1), back(front.size()) {
+    front_size = file.read(front.data(), front.size());
+    if (front_size == front.size()) {
+      read_back();
+    }
+  }
+
+  /**
+   * @brief Check whether all the records are used.
+   *
+   * @return true No record is left.
+   * @return false Some records are left.
+   */
+  bool empty() const noexcept { return pos == front_size; }
+
+  /**
+   * @brief Move to the next record, switching to the block read ahead at the
+   * end of the current one.
+   * @pre `!empty()`.
+   * @throw std::runtime_error The file could not be read.
+   */
+  void next() {
+    if (++pos < front_size || front_size < front.size()) {
+      return;
+    }
+    pending.wait();
+    front.swap(back);
+    front_size = back_size;
+    back_size = 0;
+    pos = 0;
+    if (front_size == front.size()) {
+      read_back();
+    }
+  }
+
+  /**
+   * @brief Get the iterator to the current record.
+   *
+   * @return iterator The iterator.
+   */
+  iterator begin() { return iterator(this); }
+
+  /**
+   * @brief Get the end iterator.
+   *
+   * @return iterator The iterator.
+   */
+  iterator end() { return iterator(); }
+};
+
+/**
+ * @brief Records appended to a file a block at a time, the full block being
+ * written by a task while the next one is filled.
+ *
+ * @tparam T The type of the records, which must be trivially copyable.
+ * @note `flush` must be called before the writer is destroyed, otherwise the
+ * records not written yet are lost.
+ */
+template <class T> class external_block_writer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_block_writer needs trivially copyable records");
+
+private:
+  external_file &file;
+  tiny_stl::vector<T> front;
+  tiny_stl::vector<T> back;
+  std::size_t front_size = 0;
+  // The write of `back`, declared last to be waited for first.
+  task_group pending;
+
+  void write_front() {
+    pending.wait();
+    front.swap(back);
+    const std::size_t n = front_size;
+    front_size = 0;
+    pending.run([this, n] { file.write(back.data(), n); });
+  }
+
+public:
+  /**
+   * @brief Start writing a file.
+   *
+   * @param f The file, written from its current position.
+   * @param block The number of records of a write, at least 1.
+   */
+  external_block_writer(external_file &f, std::size_t block)
+      : file(f), front(block > 0 ? block : 1), back(front.size()) {}
+
+  /**
+   * @brief Append a record.
+   *
+   * @param value The record.
+   * @throw std::runtime_error The file could not be written.
+   */
+  void push(const T &value) {
+    front[front_size] = value;
+    if (++front_size == front.size()) {
+      write_front();
+    }
+  }
+
+  /**
+   * @brief Write all the records appended.
+   *
+   * @throw std::runtime_error The file could not be written.
+   */
+  void flush() {
+    write_front();
+    pending.wait();
+    file.flush();
+  }
+};
+
+/**
+ * @brief Sort the records of an input range into the memory budget, spill the
+ * sorted runs, and merge them into a sink.
+ *
+ * @tparam T The type of the records.
+ * @tparam InputIter The type of the iterator of the input.
+ * @tparam Sink The type of the function taking the sorted records.
+ * @tparam Compare The type of the comparator.
+ * @param first The beginning of the input.
+ * @param last The end of the input.
+ * @param sink The function, called with every record in sorted order.
+ * @param memory_bytes The memory budget for the records in bytes.
+ * @param comp The comparator.
+ * @param spill_dir The directory of the runs, as for
+ * `external_file::temporary`.
+ */
+template <class T, class InputIter, class Sink, class Compare>
+void external_sort_into(InputIter first, InputIter last, Sink &sink,
+                        std::size_t memory_bytes, Compare comp,
+                        const char *spill_dir) {
+  // Two runs are in memory: the one being sorted, and the one being written.
+  std::size_t run_size = memory_bytes / sizeof(T) / 2;
+  run_size = run_size > 0 ? run_size : 1;
+  tiny_stl::vector<external_file> runs;
+  {
+    tiny_stl::vector<T> filling(run_size);
+    tiny_stl::vector<T> writing(run_size);
+    task_group spill;
+    while (first != last) {
+      std::size_t n = 0;
+      for (; n < run_size && first != last; ++n, ++first) {
+        filling[n] = *first;
+      }
+      tiny_stl::sort(filling.data(), filling.data() + n, comp);
+      if (runs.empty() && first == last) {
+        // All the records fit in memory.
+        for (std::size_t i = 0; i < n; ++i) {
+          sink(filling[i]);
+        }
+        return;
+      }
+      spill.wait();
+      filling.swap(writing);
+      runs.push_back(external_file::temporary(spill_dir));
+      external_file *run = &runs.back();
+      const T *data = writing.data();
+      spill.run([run, data, n] {
+        run->write(data, n);
+        run->rewind();
+      });
+    }
+    spill.wait();
+  }
+  if (runs.empty()) {
+    return;
+  }
+
+  // Two blocks for each run, and the rest of the budget left to the sink.
+  const std::size_t k = runs.size();
+  std::size_t block = memory_bytes / sizeof(T) / (2 * k + 2);
+  block = block > 0 ? block : 1;
+  tiny_stl::vector<std::unique_ptr<external_block_reader<T>>> readers;
+  using iterator = typename external_block_reader<T>::iterator;
+  tiny_stl::vector<tiny_stl::pair<iterator, iterator>> sources;
+  for (auto &run : runs) {
+    readers.emplace_back(new external_block_reader<T>(run, block));
+    sources.emplace_back(readers.back()->begin(), readers.back()->end());
+  }
+  tiny_stl::loser_tree<iterator, Compare> tree(sources.begin(), sources.end(),
+                                               comp);
+  for (; !tree.empty(); tree.pop()) {
+    sink(tree.top());
+  }
+}
+
+/**
+ * @brief Sort the records of an input range into an output iterator, using
+ * about a fixed amount of memory whatever the size of the input.
+ *
+ * @details The input is read a memory load at a time, each load is sorted by
+ * `tiny_stl::sort` and spilled to a temporary file while the next one is read,
+ * and all the spilled runs are merged in one pass. An input fitting in the
+ * budget is sorted in memory without any file.
+ *
+ * @tparam InputIter The type of the iterator of the input, whose records must
+ * be trivially copyable.
+ * @tparam OutputIter The type of the output iterator.
+ * @tparam Compare The type of the comparator.
+ * @param first The beginning of the input.
+ * @param last The end of the input.
+ * @param result The beginning of the output.
+ * @param memory_bytes The memory budget for the records in bytes.
+ * @param comp The comparator.
+ * @param spill_dir The directory the runs are spilled to, `TMPDIR` or the
+ * system temporary directory when null.
+ * @return OutputIter The end of the output.
+ * @throw std::runtime_error A temporary file could not be created, written or
+ * read.
+ * @note The sort is not stable. The merge reads two blocks of every run, so
+ * the blocks get smaller as the input grows against the budget: about 1000
+ * runs still leave 1/2000 of the budget to every block.
+ */
+template <class InputIter, class OutputIter, class Compare>
+OutputIter external_sort(InputIter first, InputIter last, OutputIter result,
+                         std::size_t memory_bytes, Compare comp,
+                         const char *spill_dir = nullptr) {
+  using T = std::decay_t<decltype(*first)>;
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_sort needs trivially copyable records");
+  auto sink = [&result](const T &value) {
+    *result = value;
+    ++result;
+  };
+  tiny_stl::external_sort_into<T>(first, last, sink, memory_bytes, comp,
+                                  spill_dir);
+  return result;
+}
+
+/**
+ * @brief Sort the records of an input range into an output iterator by
+ * `operator<`, using about a fixed amount of memory.
+ *
+ * @tparam InputIter The type of the iterator of the input, whose records must
+ * be trivially copyable.
+ * @tparam OutputIter The type of the output iterator.
+ * @param first The beginning of the input.
+ * @param last The end of the input.
+ * @param result The beginning of the output.
+ * @param memory_bytes The memory budget for the records in bytes.
+ * @return OutputIter The end of the output.
+ * @throw std::runtime_error A temporary file could not be created, written or
+ * read.
+ */
+template <class InputIter, class OutputIter>
+OutputIter external_sort(InputIter first, InputIter last, OutputIter result,
+                         std::size_t memory_bytes) {
+  using T = std::decay_t<decltype(*first)>;
+  return tiny_stl::external_sort(first, last, result, memory_bytes,
+                                 tiny_stl::less<T>());
+}
+
+/**
+ * @brief Sort a binary file of records into another file, using about a fixed
+ * amount of memory.
+ *
+ * @tparam T The type of the records, which must be trivially copyable.
+ * @tparam Compare The type of the comparator.
+ * @param input The path of the input file, a sequence of records.
+ * @param output The path of the output file, replaced if it exists.
+ * @param memory_bytes The memory budget for the records in bytes.
+ * @param comp The comparator.
+ * @param spill_dir The directory the runs are spilled to, `TMPDIR` or the
+ * system temporary directory when null.
+ * @throw std::runtime_error A file could not be opened, written or read, or
+ * the input ends in the middle of a record.
+ */
+template <class T, class Compare>
+void external_sort_file(const char *input, const char *output,
+                        std::size_t memory_bytes, Compare comp,
+                        const char *spill_dir = nullptr) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_sort_file needs trivially copyable records");
+  // A few blocks of the budget buffer the input and the output files.
+  std::size_t block = memory_bytes / sizeof(T) / 16;
+  block = block > 0 ? block : 1;
+  external_file in(input, "rb");
+  external_file out(output, "wb");
+  external_block_reader<T> reader(in, block);
+  external_block_writer<T> writer(out, block);
+  auto sink = [&writer](const T &value) { writer.push(value); };
+  tiny_stl::external_sort_into<T>(reader.begin(), reader.end(), sink,
+                                  memory_bytes - memory_bytes / 4, comp,
+                                  spill_dir);
+  writer.flush();
+}
+
+/**
+ * @brief Sort a binary file of records by `operator<` into another file, using
+ * about a fixed amount of memory.
+ *
+ * @tparam T The type of the records, which must be trivially copyable.
+ * @param input The path of the input file, a sequence of records.
+ * @param output The path of the output file, replaced if it exists.
+ * @param memory_bytes The memory budget for the records in bytes.
+ * @throw std::runtime_error A file could not be opened, written or read, or
+ * the input ends in the middle of a record.
+ */
+template <class T>
+void external_sort_file(const char *input, const char *output,
+                        std::size_t memory_bytes) {
+  tiny_stl::external_sort_file<T>(input, output, memory_bytes,
+                                  tiny_stl::less<T>());
+}
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__EXTERNAL_SORT_HPP
@@ -37,6 +37,7 @@
 #define TINY_STL__INCLUDE__FUNCTIONAL_HPP
 
 #include <cstddef>
+#include <limits>
 
 namespace tiny_stl {
 
@@ -414,15 +415,20 @@ template <> struct hash<double> {
 /**
  * @brief The partial specialization of `hash` for `long double`
  * @note For floating-point numbers, the hash function is implemented by
- * bitwise hashing.
+ * bitwise hashing. Only the bytes of the value are hashed: the x87 extended
+ * format keeps it in the first 10 bytes, and the padding after them holds
+ * whatever was in the memory before.
  *
  * @tparam T The type of the argument.
  */
 template <> struct hash<long double> {
   size_t operator()(const long double &val) {
+    constexpr size_t value_bytes =
+        std::numeric_limits<long double>::digits == 64 ? 10
+                                                       : sizeof(long double);
     return val == 0.0f
                ? 0
-               : bitwise_hash((const unsigned char *)&val, sizeof(long double));
+               : bitwise_hash((const unsigned char *)&val, value_bytes);
   }
 };
 
@@ -18,6 +18,7 @@
 #define TINY_STL__INCLUDE__HEAP_ALGO_HPP
 
 #include "iterator.hpp"
+#include "utility.hpp"
 
 namespace tiny_stl {
 
@@ -42,11 +43,11 @@ void push_heap_aux(RandomAccessIter first, Distance holeIndex,
                    Distance topIndex, T value) {
   auto parent = (holeIndex - 1) / 2;
   while (holeIndex > topIndex && *(first + parent) < value) {
-    *(first + holeIndex) = *(first + parent);
+    *(first + holeIndex) = tiny_stl::move(*(first + parent));
     holeIndex = parent;
     parent = (holeIndex - 1) / 2;
   }
-  *(first + holeIndex) = value;
+  *(first + holeIndex) = tiny_stl::move(value);
 }
 
 /**
@@ -65,7 +66,7 @@ void push_heap_aux(RandomAccessIter first, Distance holeIndex,
 template <class RandomAccessIter, class Distance>
 void push_heap_d(RandomAccessIter first, RandomAccessIter last, Distance *) {
   tiny_stl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
-                          *(last - 1));
+                          tiny_stl::move(*(last - 1)));
 }
 
 /**
@@ -105,11 +106,11 @@ void push_heap_aux(RandomAccessIter first, Distance holeIndex,
                    Distance topIndex, T value, Compare compare) {
   auto parent = (holeIndex - 1) / 2;
   while (holeIndex > topIndex && compare(*(first + parent), value)) {
-    *(first + holeIndex) = *(first + parent);
+    *(first + holeIndex) = tiny_stl::move(*(first + parent));
     holeIndex = parent;
     parent = (parent - 1) / 2;
   }
-  *(first + holeIndex) = value;
+  *(first + holeIndex) = tiny_stl::move(value);
 }
 
 /**
@@ -131,7 +132,7 @@ template <class RandomAccessIter, class Compare, class Distance>
 void push_heap_d(RandomAccessIter first, RandomAccessIter last, Distance *,
                  Compare compare) {
   push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
-                *(last - 1), compare);
+                tiny_stl::move(*(last - 1)), compare);
 }
 
 /**
@@ -199,17 +200,17 @@ void adjust_heap(RandomAccessIter first, Distance holeIndex, Distance len,
         *(first + rchild - 1)) { // choose the greater elem in the children
       --rchild;
     }
-    *(first + holeIndex) =
-        *(first + rchild); // Assign the greater child to the hole.
+    *(first + holeIndex) = tiny_stl::move(
+        *(first + rchild)); // Assign the greater child to the hole.
     holeIndex = rchild;
     rchild = 2 * (rchild + 1);
   }
   if (rchild == len) {
-    *(first + holeIndex) = *(first + (rchild - 1));
+    *(first + holeIndex) = tiny_stl::move(*(first + (rchild - 1)));
     holeIndex = rchild - 1;
   }
   tiny_stl::push_heap_aux(first, holeIndex, topIndex,
-                          value); // Re-push the value.
+                          tiny_stl::move(value)); // Re-push the value.
 }
 
 /**
@@ -231,8 +232,9 @@ void adjust_heap(RandomAccessIter first, Distance holeIndex, Distance len,
 template <class RandomAccessIter, class T, class Distance>
 void pop_heap_aux(RandomAccessIter first, RandomAccessIter last,
                   RandomAccessIter dest, T value, Distance *) {
-  *dest = *first;
-  tiny_stl::adjust_heap(first, static_cast<Distance>(0), last - first, value);
+  *dest = tiny_stl::move(*first);
+  tiny_stl::adjust_heap(first, static_cast<Distance>(0), last - first,
+                        tiny_stl::move(value));
 }
 
 /**
@@ -245,7 +247,7 @@ void pop_heap_aux(RandomAccessIter first, RandomAccessIter last,
  */
 template <class RandomAccessIter>
 void pop_heap(RandomAccessIter first, RandomAccessIter last) {
-  tiny_stl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+  tiny_stl::pop_heap_aux(first, last - 1, last - 1, tiny_stl::move(*(last - 1)),
                          distance_type(first));
 }
 
@@ -272,15 +274,16 @@ void adjust_heap(RandomAccessIter first, Distance holeIndex, Distance len,
     if (compare(*(first + rchild), *(first + rchild - 1))) {
       --rchild;
     }
-    *(first + holeIndex) = *(first + rchild);
+    *(first + holeIndex) = tiny_stl::move(*(first + rchild));
     holeIndex = rchild;
     rchild = 2 * (rchild + 1);
   }
   if (rchild == len) {
-    *(first + holeIndex) = *(first + (rchild - 1));
+    *(first + holeIndex) = tiny_stl::move(*(first + (rchild - 1)));
     holeIndex = rchild - 1;
   }
-  tiny_stl::push_heap_aux(first, holeIndex, topIndex, value, compare);
+  tiny_stl::push_heap_aux(first, holeIndex, topIndex, tiny_stl::move(value),
+                          compare);
 }
 
 /**
@@ -304,9 +307,9 @@ void adjust_heap(RandomAccessIter first, Distance holeIndex, Distance len,
 template <class RandomAccessIter, class T, class Distance, class Compare>
 void pop_heap_aux(RandomAccessIter first, RandomAccessIter last,
                   RandomAccessIter dest, T value, Distance *, Compare compare) {
-  *dest = *first;
-  tiny_stl::adjust_heap(first, static_cast<Distance>(0), last - first, value,
-                        compare);
+  *dest = tiny_stl::move(*first);
+  tiny_stl::adjust_heap(first, static_cast<Distance>(0), last - first,
+                        tiny_stl::move(value), compare);
 }
 
 /**
@@ -321,7 +324,7 @@ void pop_heap_aux(RandomAccessIter first, RandomAccessIter last,
  */
 template <class RandomAccessIter, class Compare>
 void pop_heap(RandomAccessIter first, RandomAccessIter last, Compare compare) {
-  tiny_stl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+  tiny_stl::pop_heap_aux(first, last - 1, last - 1, tiny_stl::move(*(last - 1)),
                          distance_type(first), compare);
 }
 
@@ -377,7 +380,8 @@ void make_heap_aux(RandomAccessIter first, RandomAccessIter last, Distance *) {
   auto len = last - first;
   auto holeIndex = (len - 2) / 2; // The last parent node index
   while (true) {
-    tiny_stl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+    tiny_stl::adjust_heap(first, holeIndex, len,
+                          tiny_stl::move(*(first + holeIndex)));
     if (holeIndex == 0) {
       return;
     }
@@ -420,7 +424,8 @@ void make_heap_aux(RandomAccessIter first, RandomAccessIter last, Distance *,
   auto len = last - first;
   auto holeIndex = (len - 2) / 2;
   while (true) {
-    tiny_stl::adjust_heap(first, holeIndex, len, *(first + holeIndex), compare);
+    tiny_stl::adjust_heap(first, holeIndex, len,
+                          tiny_stl::move(*(first + holeIndex)), compare);
     if (holeIndex == 0) {
       return;
     }
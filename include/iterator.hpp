@@ -10,6 +10,7 @@
  *    - `forward_iterator_tag`
  *    - `bidirectional_iterator_tag`
  *    - `random_access_iterator_tag`
+ *    - `contiguous_iterator_tag`
  * - iterator class implementation `iterator`
  * - iterator traits extraction mechanism
  *    - `has_iterator_cat`
@@ -23,11 +24,13 @@
  *    - `is_forward_iterator`
  *    - `is_bidirectional_iterator`
  *    - `is_random_iterator`
+ *    - `is_contiguous_iterator`
  *    - `is_iterator`
  * - iterator traits helper functions
  *    - `iterator_category`
  *    - `distance_type`
  *    - `value_type`
+ *    - `to_address`
  * - iterator operations
  *    - `distance_dispatch`
  *    - `distance`
@@ -35,6 +38,7 @@
  *    - `advance`
  * - reverse iterator
  *    - `reverse_iterator`
+ *    - `is_reverse_iterator`
  * - reverse iterator operations
  */
 #ifndef TINY_STL__INCLUDE__ITERATOR_HPP
@@ -85,6 +89,16 @@ struct bidirectional_iterator_tag : public forward_iterator_tag {};
  */
 struct random_access_iterator_tag : public bidirectional_iterator_tag {};
 
+/**
+ * @brief Contiguous iterator tag
+ *
+ * @details An iterator with this tag is a random access iterator whose elements
+ * are adjacent in memory, so `tiny_stl::to_address` can turn it into a native
+ * pointer. The algorithms unwrap such iterators to reach the `memmove` and
+ * `memset` fast paths of native pointers.
+ */
+struct contiguous_iterator_tag : public random_access_iterator_tag {};
+
 template <class Category, class T, class Distance = ptrdiff_t,
           class Pointer = T *, class Reference = T &>
 struct iterator {
@@ -342,6 +356,27 @@ template <class Iter>
 struct is_random_iterator
     : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
 
+/**
+ * @brief Check if `Iter` is a contiguous iterator, i.e. a native pointer or an
+ * iterator of category `contiguous_iterator_tag`
+ *
+ * @tparam Iter The type of iterator
+ */
+template <class Iter>
+struct is_contiguous_iterator
+    : public compile_time_constant_bool<
+          std::is_pointer_v<Iter> ||
+          has_iterator_cat_of<Iter, contiguous_iterator_tag>::value> {};
+
+/**
+ * @brief Helper variable template of `is_contiguous_iterator`
+ *
+ * @tparam Iter The type of iterator
+ */
+template <class Iter>
+inline constexpr bool is_contiguous_iterator_v =
+    is_contiguous_iterator<Iter>::value;
+
 /**
  * @brief Check if `Iter` is iterator
  * @details All categories of iterators can be converted into either
@@ -396,6 +431,30 @@ typename iterator_traits<Iter>::value_type *value_type(const Iter &) {
   return Value(0);
 }
 
+/**
+ * @brief Get the address pointed by a native pointer
+ *
+ * @tparam T The type pointed by the pointer
+ * @param ptr The pointer
+ * @return T* The pointer itself
+ */
+template <class T> constexpr T *to_address(T *ptr) noexcept { return ptr; }
+
+/**
+ * @brief Get the address pointed by a contiguous iterator
+ * @details The iterator is unwrapped by its `operator->`, until a native
+ * pointer is reached. It is valid for the end iterator as well, so an
+ * iterator type opting in `contiguous_iterator_tag` must not check the
+ * position in `operator->`.
+ *
+ * @tparam Iter The type of iterator
+ * @param iter The iterator
+ * @return auto The native pointer to the element
+ */
+template <class Iter> constexpr auto to_address(const Iter &iter) noexcept {
+  return tiny_stl::to_address(iter.operator->());
+}
+
 /**
  * @brief Get the distance between two input iterators
  *
@@ -530,8 +589,13 @@ private:
   Iterator current;
 
 public:
-  using iterator_category =
-      typename iterator_traits<Iterator>::iterator_category;
+  // The reversed elements are not adjacent in increasing order any more.
+  using iterator_category = std::conditional_t<
+      std::is_convertible_v<
+          typename iterator_traits<Iterator>::iterator_category,
+          contiguous_iterator_tag>,
+      random_access_iterator_tag,
+      typename iterator_traits<Iterator>::iterator_category>;
   using value_type = typename iterator_traits<Iterator>::value_type;
   using difference_type = typename iterator_traits<Iterator>::difference_type;
   using pointer = typename iterator_traits<Iterator>::pointer;
@@ -793,6 +857,16 @@ bool operator>=(const reverse_iterator<Iterator> &lhs,
   return !(lhs < rhs);
 }
 
+/**
+ * @brief Check if `T` is a `reverse_iterator`
+ *
+ * @tparam T The type to be checked
+ */
+template <class T> struct is_reverse_iterator : public false_type {};
+
+template <class Iterator>
+struct is_reverse_iterator<reverse_iterator<Iterator>> : public true_type {};
+
 } // namespace tiny_stl
 
 #endif // !TINY_STL__INCLUDE__ITERATOR_HPP
\ No newline at end of file
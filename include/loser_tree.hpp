@@ -0,0 +1,185 @@
+/**
+ * @file loser_tree.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains a tournament tree merging many sorted sources.
+ *
+ * @details Merging `K` sorted sources with a binary heap sifts the heap once
+ * per element, about `2 * log(K)` comparisons. A loser tree keeps the loser
+ * of every match in the inner nodes instead, so when the winner is replaced
+ * by the next element of its source, only the matches on its path to the root
+ * are replayed, one comparison per level. This file contains the following
+ * utilities:
+ * - `loser_tree`: the elements of `K` sorted sources in sorted order, pulled
+ * lazily one at a time.
+ */
+#ifndef TINY_STL__INCLUDE__LOSER_TREE_HPP
+#define TINY_STL__INCLUDE__LOSER_TREE_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "functional.hpp"
+
+namespace tiny_stl {
+
+/**
+ * @brief The elements of several sorted sources, in sorted order, through a
+ * tournament tree of losers.
+ *
+ * @details Source `i` is leaf `K + i` of an implicit binary tree with inner
+ * nodes `1` to `K - 1`, where node `p` has children `2 * p` and `2 * p + 1`.
+ * Every inner node keeps the source which lost the match played there, and
+ * the overall winner is kept aside. The sources are read only through their
+ * current iterator, one element ahead at most, so they can be input
+ * iterators, like the iterators of a stream.
+ *
+ * @tparam InputIter The type of the iterators of the sources.
+ * @tparam Compare The type of the comparator, the sources must be sorted by
+ * it.
+ * @note Equal elements come out in the order of their sources, and in their
+ * order inside a source, as in a stable merge.
+ */
+template <class InputIter,
+          class Compare = tiny_stl::less<std::decay_t<
+              decltype(*std::declval<InputIter &>())>>>
+class loser_tree {
+public:
+  using iterator = InputIter;
+  using reference = decltype(*std::declval<InputIter &>());
+  using size_type = std::size_t;
+
+private:
+  std::vector<InputIter> cursors;
+  std::vector<InputIter> ends;
+  // The loser of the match at every inner node, `losers[0]` is unused. An
+  // exhausted source is replaced by `sources()`, which loses every match.
+  std::vector<size_type> losers;
+  size_type winner = 0;
+  Compare comp;
+
+  size_type live(size_type s) const {
+    return cursors[s] == ends[s] ? cursors.size() : s;
+  }
+
+  // Whether source `a` wins its match against source `b`, the ties go to
+  // the first source. Cheap comparisons are both made, which avoids a branch
+  // as unpredictable as the winner, otherwise only one of them is needed.
+  bool beats(size_type a, size_type b) {
+    const size_type none = cursors.size();
+    if (a == none)
+      return false;
+    if (b == none)
+      return true;
+    if constexpr (std::is_arithmetic_v<std::decay_t<reference>>) {
+      const bool less = comp(*cursors[a], *cursors[b]);
+      const bool greater = comp(*cursors[b], *cursors[a]);
+      return less | (!greater & (a < b));
+    } else {
+      return a < b ? !comp(*cursors[b], *cursors[a])
+                   : comp(*cursors[a], *cursors[b]);
+    }
+  }
+
+  // Play all the matches, from the bottom up.
+  void build() {
+    const size_type k = cursors.size();
+    if (k == 0)
+      return;
+    losers.assign(k, 0);
+    std::vector<size_type> winners(2 * k);
+    for (size_type s = 0; s < k; ++s)
+      winners[k + s] = live(s);
+    for (size_type p = k - 1; p > 0; --p) {
+      const size_type left = winners[2 * p];
+      const size_type right = winners[2 * p + 1];
+      const bool left_wins = beats(left, right);
+      winners[p] = left_wins ? left : right;
+      losers[p] = left_wins ? right : left;
+    }
+    winner = winners[1 < k ? 1 : k];
+  }
+
+public:
+  /**
+   * @brief Construct a tree over no source.
+   */
+  loser_tree() = default;
+
+  /**
+   * @brief Construct a tree over some sources.
+   * @pre Every source is sorted by `comp`.
+   *
+   * @tparam RangeIter The type of the iterator of the sources, each of which
+   * is a pair of iterators with members `first` and `second`.
+   * @param first The beginning of the sources.
+   * @param last The end of the sources.
+   * @param comp The comparator.
+   */
+  template <class RangeIter>
+  loser_tree(RangeIter first, RangeIter last, Compare comp = Compare())
+      : comp(comp) {
+    for (; first != last; ++first) {
+      cursors.push_back((*first).first);
+      ends.push_back((*first).second);
+    }
+    build();
+  }
+
+  /**
+   * @brief Get the number of sources.
+   *
+   * @return size_type The number of sources, including the exhausted ones.
+   */
+  size_type sources() const noexcept { return cursors.size(); }
+
+  /**
+   * @brief Check whether all the sources are exhausted.
+   *
+   * @return true No element is left.
+   * @return false Some elements are left.
+   */
+  bool empty() const noexcept { return winner == cursors.size(); }
+
+  /**
+   * @brief Get the least element left.
+   * @pre `!empty()`.
+   *
+   * @return reference The element.
+   */
+  reference top() const { return *cursors[winner]; }
+
+  /**
+   * @brief Get the source of the least element left.
+   * @pre `!empty()`.
+   *
+   * @return size_type The index of the source.
+   */
+  size_type source() const noexcept { return winner; }
+
+  /**
+   * @brief Remove the least element left, and pull the next element of its
+   * source.
+   * @pre `!empty()`.
+   */
+  void pop() {
+    const size_type k = cursors.size();
+    ++cursors[winner];
+    size_type s = live(winner);
+    for (size_type p = (k + winner) / 2; p > 0; p /= 2) {
+      // Swapped by a mask rather than a branch, since who wins is as
+      // unpredictable as the elements.
+      const size_type loser = losers[p];
+      const size_type mask = size_type(0) - size_type(beats(loser, s));
+      const size_type diff = (loser ^ s) & mask;
+      losers[p] = loser ^ diff;
+      s ^= diff;
+    }
+    winner = s;
+  }
+};
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__LOSER_TREE_HPP
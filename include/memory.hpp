@@ -203,7 +203,8 @@ private:
 
 template <class ForwardIter, class T>
 temporary_buffer<ForwardIter, T>::temporary_buffer(ForwardIter first,
-                                                   ForwardIter last) {
+                                                   ForwardIter last)
+    : original_len(0), len(0), buffer(nullptr) {
   try {
     len = tiny_stl::distance(first, last);
     allocate_buffer();
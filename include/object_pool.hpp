@@ -0,0 +1,291 @@
+/**
+ * @file object_pool.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains a pool which recycles constructed objects.
+ *
+ * @details This file contains the following utilities:
+ * - `null_mutex`: a lock which does nothing, used by single-threaded pools.
+ * - `no_reset`: the default reset hook, which leaves the object untouched.
+ * - `object_pool`: a pool handing out constructed objects and taking them back
+ * without running the destructor and constructor in between.
+ * - `concurrent_object_pool`: the thread-safe edition of `object_pool`.
+ */
+#ifndef TINY_STL__INCLUDE__OBJECT_POOL_HPP
+#define TINY_STL__INCLUDE__OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <mutex>
+
+#include "allocator.hpp"
+#include "construct.hpp"
+
+namespace tiny_stl {
+
+/**
+ * @brief A lock which does nothing.
+ * @note It satisfies the requirements of `std::lock_guard`, so a pool used by
+ * only one thread pays nothing for locking.
+ */
+struct null_mutex {
+  void lock() noexcept {}
+  void unlock() noexcept {}
+};
+
+/**
+ * @brief The default reset hook of `object_pool`, which does nothing.
+ *
+ * @tparam T The type of the pooled object.
+ */
+template <class T> struct no_reset {
+  void operator()(T &) const noexcept {}
+};
+
+/**
+ * @brief A pool which recycles constructed objects.
+ *
+ * @details The objects handed out by `acquire` are constructed only once, when
+ * the pool creates them. `release` gives an object back to the pool, the reset
+ * hook is applied to it and it waits for the next `acquire`, which means the
+ * resources owned by the object (e.g. internal buffers) are kept between two
+ * uses. All the objects are destroyed when the pool is destroyed.
+ *
+ * Objects are created block by block, a block is allocated when no idle object
+ * is left, and its slots are constructed lazily. `reserve` constructs a batch
+ * of idle objects at once.
+ *
+ * @warning Objects still held by the user when the pool is destroyed are
+ * destroyed as well, so they must not be used any more.
+ *
+ * @tparam T The type of the pooled object, which must be default
+ * constructible.
+ * @tparam Reset The type of the hook applied to an object when it is released.
+ * @tparam Mutex The type of the lock guarding the pool.
+ */
+template <class T, class Reset = tiny_stl::no_reset<T>,
+          class Mutex = tiny_stl::null_mutex>
+class object_pool {
+public:
+  using value_type = T;
+  using pointer = T *;
+  using reference = T &;
+  using size_type = size_t;
+  using reset_type = Reset;
+  using mutex_type = Mutex;
+
+private:
+  /**
+   * @brief A slot holding an object, and the link to the next idle slot.
+   * @note `storage` is the first member, so the address of the object is also
+   * the address of the slot.
+   */
+  struct node {
+    alignas(T) unsigned char storage[sizeof(T)];
+    node *next;
+  };
+
+  /**
+   * @brief A batch of slots allocated at once.
+   */
+  struct block {
+    node *nodes;     // The slots of the block.
+    size_type size;  // The number of slots.
+    size_type used;  // The number of slots whose object has been constructed.
+    block *next;     // The block allocated before this one.
+  };
+
+  using node_allocator = tiny_stl::allocator<node>;
+  using block_allocator = tiny_stl::allocator<block>;
+
+  static constexpr size_type kMinBlockSize = 32;
+
+  block *blocks;          // The most recently allocated block.
+  node *free_list;        // The idle objects.
+  size_type idle_count;   // The number of idle objects.
+  size_type total_count;  // The number of objects constructed.
+  size_type next_size;    // The size of the next block.
+  Reset reset_hook;       // The hook applied when an object is released.
+  mutable Mutex mutex;    // The lock guarding all the fields above.
+
+public:
+  /**
+   * @brief Construct a new object pool.
+   *
+   * @param n The number of objects constructed in advance.
+   * @param reset The hook applied to an object when it is released.
+   */
+  explicit object_pool(size_type n = 0, const Reset &reset = Reset())
+      : blocks(nullptr), free_list(nullptr), idle_count(0), total_count(0),
+        next_size(kMinBlockSize), reset_hook(reset) {
+    if (n > 0) {
+      try {
+        reserve(n);
+      } catch (...) {
+        clear();
+        throw;
+      }
+    }
+  }
+
+  /**
+   * @brief Destroy the object pool, and all the objects it created.
+   */
+  ~object_pool() { clear(); }
+
+public:
+  /**
+   * @brief Get an object from the pool.
+   * @note An idle object is returned if there is one, otherwise a new object
+   * will be default constructed.
+   *
+   * @return T* The object.
+   */
+  T *acquire();
+
+  /**
+   * @brief Give an object back to the pool.
+   * @note The reset hook is applied to the object, the object is not destroyed.
+   * @warning `ptr` must be returned by `acquire` of this pool.
+   *
+   * @param ptr The object, nothing will be done if it is `nullptr`.
+   */
+  void release(T *ptr);
+
+  /**
+   * @brief Construct objects until there are at least `n` idle objects.
+   * @note The new objects are allocated in one block.
+   *
+   * @param n The number of idle objects wanted.
+   */
+  void reserve(size_type n);
+
+  /**
+   * @brief Get the number of idle objects.
+   *
+   * @return size_type The number of idle objects.
+   */
+  size_type idle() const {
+    std::lock_guard<Mutex> guard(mutex);
+    return idle_count;
+  }
+
+  /**
+   * @brief Get the number of objects constructed by the pool.
+   *
+   * @return size_type The number of objects, both in use and idle.
+   */
+  size_type size() const {
+    std::lock_guard<Mutex> guard(mutex);
+    return total_count;
+  }
+
+private:
+  /**
+   * @brief Allocate a block with `n` slots, no object is constructed.
+   *
+   * @param n The number of slots.
+   */
+  void allocate_block(size_type n);
+
+  /**
+   * @brief Destroy all the objects and release all the blocks.
+   */
+  void clear() noexcept;
+
+private:
+  object_pool(const object_pool &) = delete;
+  object_pool &operator=(const object_pool &) = delete;
+};
+
+/**
+ * @brief The thread-safe edition of `object_pool`.
+ *
+ * @tparam T The type of the pooled object.
+ * @tparam Reset The type of the hook applied to an object when it is released.
+ */
+template <class T, class Reset = tiny_stl::no_reset<T>>
+using concurrent_object_pool = object_pool<T, Reset, std::mutex>;
+
+template <class T, class Reset, class Mutex>
+T *object_pool<T, Reset, Mutex>::acquire() {
+  std::lock_guard<Mutex> guard(mutex);
+  if (free_list) {
+    node *result = free_list;
+    free_list = free_list->next;
+    --idle_count;
+    return reinterpret_cast<T *>(result->storage);
+  }
+  if (!blocks || blocks->used == blocks->size) {
+    allocate_block(next_size);
+    next_size += next_size;
+  }
+  node *slot = blocks->nodes + blocks->used;
+  T *result = reinterpret_cast<T *>(slot->storage);
+  tiny_stl::construct(result);
+  ++blocks->used;
+  ++total_count;
+  return result;
+}
+
+template <class T, class Reset, class Mutex>
+void object_pool<T, Reset, Mutex>::release(T *ptr) {
+  if (ptr == nullptr)
+    return;
+  reset_hook(*ptr);
+  std::lock_guard<Mutex> guard(mutex);
+  node *slot = reinterpret_cast<node *>(ptr);
+  slot->next = free_list;
+  free_list = slot;
+  ++idle_count;
+}
+
+template <class T, class Reset, class Mutex>
+void object_pool<T, Reset, Mutex>::reserve(size_type n) {
+  std::lock_guard<Mutex> guard(mutex);
+  if (idle_count >= n)
+    return;
+  const size_type add = n - idle_count;
+  allocate_block(add);
+  for (; blocks->used != blocks->size; ++blocks->used) {
+    node *slot = blocks->nodes + blocks->used;
+    tiny_stl::construct(reinterpret_cast<T *>(slot->storage));
+    slot->next = free_list;
+    free_list = slot;
+    ++idle_count;
+    ++total_count;
+  }
+}
+
+template <class T, class Reset, class Mutex>
+void object_pool<T, Reset, Mutex>::allocate_block(size_type n) {
+  block *new_block = block_allocator::allocate();
+  try {
+    new_block->nodes = node_allocator::allocate(n);
+  } catch (...) {
+    block_allocator::deallocate(new_block);
+    throw;
+  }
+  new_block->size = n;
+  new_block->used = 0;
+  new_block->next = blocks;
+  blocks = new_block;
+}
+
+template <class T, class Reset, class Mutex>
+void object_pool<T, Reset, Mutex>::clear() noexcept {
+  while (blocks) {
+    block *next = blocks->next;
+    for (size_type i = 0; i < blocks->used; ++i) {
+      tiny_stl::destroy(reinterpret_cast<T *>(blocks->nodes[i].storage));
+    }
+    node_allocator::deallocate(blocks->nodes, blocks->size);
+    block_allocator::deallocate(blocks);
+    blocks = next;
+  }
+  free_list = nullptr;
+  idle_count = 0;
+  total_count = 0;
+}
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__OBJECT_POOL_HPP
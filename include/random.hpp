@@ -0,0 +1,399 @@
+/**
+ * @file random.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains small and fast pseudo-random number engines.
+ *
+ * @details The engines satisfy the requirements of a uniform random bit
+ * generator, so they can be passed to `tiny_stl::shuffle` as well as to the
+ * distributions of `<random>`. None of them is fit for cryptography. This file
+ * contains the following utilities:
+ * - `splitmix64`: a 64-bit engine with a 64-bit state, mostly used to expand a
+ * seed into the state of the other engines.
+ * - `xoshiro256starstar`: a 64-bit engine with a 256-bit state, which can jump
+ * ahead by `2^128` steps to give independent streams to parallel tasks.
+ * - `pcg32`: a 32-bit engine with a 64-bit state and selectable streams.
+ * - `random_seed`: a seed taken from `std::random_device` and the clock.
+ * - `thread_random_engine`: an engine owned by the calling thread.
+ * - `uniform_bounded`: a uniform integer in `[0, range)` by Lemire's nearly
+ * divisionless method.
+ * - `uniform_unit`: a uniform real number in `(0, 1)`.
+ */
+#ifndef TINY_STL__INCLUDE__RANDOM_HPP
+#define TINY_STL__INCLUDE__RANDOM_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace tiny_stl {
+
+/**
+ * @brief The splitmix64 engine of Steele, Lea and Flood, which outputs a
+ * strong mix of a counter stepped by the golden ratio.
+ * @note Every seed gives a good sequence, even 0, so it is the engine used to
+ * seed the others.
+ */
+class splitmix64 {
+public:
+  using result_type = std::uint64_t;
+
+private:
+  std::uint64_t state;
+
+public:
+  /**
+   * @brief Construct a new engine.
+   *
+   * @param seed The seed.
+   */
+  explicit splitmix64(std::uint64_t seed = 0) noexcept : state(seed) {}
+
+  /**
+   * @brief Restart the engine from a seed.
+   *
+   * @param seed The seed.
+   */
+  void seed(std::uint64_t seed) noexcept { state = seed; }
+
+  static constexpr result_type min() noexcept { return 0; }
+
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Generate the next number.
+   *
+   * @return result_type The number.
+   */
+  result_type operator()() noexcept {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  friend bool operator==(const splitmix64 &lhs, const splitmix64 &rhs) {
+    return lhs.state == rhs.state;
+  }
+
+  friend bool operator!=(const splitmix64 &lhs, const splitmix64 &rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+/**
+ * @brief The xoshiro256** engine of Blackman and Vigna, a xor/shift/rotate
+ * generator with a period of `2^256 - 1`.
+ */
+class xoshiro256starstar {
+public:
+  using result_type = std::uint64_t;
+
+private:
+  std::uint64_t s[4];
+
+  static std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+    return (x << k) | (x >> (64 - k));
+  }
+
+public:
+  /**
+   * @brief Construct a new engine.
+   *
+   * @param seed The seed, expanded into the state by `splitmix64`.
+   */
+  explicit xoshiro256starstar(std::uint64_t seed = 0) noexcept {
+    this->seed(seed);
+  }
+
+  /**
+   * @brief Restart the engine from a seed.
+   *
+   * @param seed The seed, expanded into the state by `splitmix64`.
+   */
+  void seed(std::uint64_t seed) noexcept {
+    splitmix64 expand(seed);
+    for (auto &word : s)
+      word = expand();
+  }
+
+  static constexpr result_type min() noexcept { return 0; }
+
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Generate the next number.
+   *
+   * @return result_type The number.
+   */
+  result_type operator()() noexcept {
+    const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+  }
+
+  /**
+   * @brief Advance the engine by `2^128` steps.
+   * @details Jumping a copy of an engine `i` times gives the `i`-th of
+   * `2^128` non-overlapping streams, one per parallel task.
+   */
+  void jump() noexcept {
+    static constexpr std::uint64_t kJump[] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull,
+        0x39ABDC4529B1661Cull};
+    std::uint64_t t[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : kJump) {
+      for (int b = 0; b < 64; ++b) {
+        if (word & (std::uint64_t(1) << b)) {
+          for (int i = 0; i < 4; ++i)
+            t[i] ^= s[i];
+        }
+        (*this)();
+      }
+    }
+    for (int i = 0; i < 4; ++i)
+      s[i] = t[i];
+  }
+
+  /**
+   * @brief Skip some numbers.
+   *
+   * @param n The number of numbers to skip.
+   */
+  void discard(unsigned long long n) noexcept {
+    for (; n > 0; --n)
+      (*this)();
+  }
+
+  friend bool operator==(const xoshiro256starstar &lhs,
+                         const xoshiro256starstar &rhs) {
+    return lhs.s[0] == rhs.s[0] && lhs.s[1] == rhs.s[1] &&
+           lhs.s[2] == rhs.s[2] && lhs.s[3] == rhs.s[3];
+  }
+
+  friend bool operator!=(const xoshiro256starstar &lhs,
+                         const xoshiro256starstar &rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+/**
+ * @brief The PCG32 engine of O'Neill (XSH-RR), a 64-bit linear congruential
+ * generator whose output is a permuted 32-bit function of the state.
+ * @note The engines with different streams give different sequences from the
+ * same seed.
+ */
+class pcg32 {
+public:
+  using result_type = std::uint32_t;
+
+private:
+  std::uint64_t state;
+  std::uint64_t increment;
+
+  static constexpr std::uint64_t kMultiplier = 6364136223846793005ull;
+
+  void step() noexcept { state = state * kMultiplier + increment; }
+
+public:
+  /**
+   * @brief Construct a new engine.
+   *
+   * @param seed The seed.
+   * @param stream The stream, of which only the low 63 bits are used.
+   */
+  explicit pcg32(std::uint64_t seed = 0x853C49E6748FEA9Bull,
+                 std::uint64_t stream = 0xDA3E39CB94B95BDBull) noexcept {
+    this->seed(seed, stream);
+  }
+
+  /**
+   * @brief Restart the engine from a seed.
+   *
+   * @param seed The seed.
+   * @param stream The stream, of which only the low 63 bits are used.
+   */
+  void seed(std::uint64_t seed,
+            std::uint64_t stream = 0xDA3E39CB94B95BDBull) noexcept {
+    state = 0;
+    increment = (stream << 1) | 1;
+    step();
+    state += seed;
+    step();
+  }
+
+  static constexpr result_type min() noexcept { return 0; }
+
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Generate the next number.
+   *
+   * @return result_type The number.
+   */
+  result_type operator()() noexcept {
+    const std::uint64_t old = state;
+    step();
+    const auto xorshifted =
+        static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+    const auto rot = static_cast<std::uint32_t>(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+  }
+
+  /**
+   * @brief Skip some numbers in `O(log(n))` steps.
+   *
+   * @param n The number of numbers to skip.
+   */
+  void discard(unsigned long long n) noexcept {
+    // Square the affine step `state * mul + add` once per bit of `n`.
+    std::uint64_t mul = kMultiplier;
+    std::uint64_t add = increment;
+    std::uint64_t acc_mul = 1;
+    std::uint64_t acc_add = 0;
+    for (; n > 0; n >>= 1) {
+      if (n & 1) {
+        acc_mul *= mul;
+        acc_add = acc_add * mul + add;
+      }
+      add = (mul + 1) * add;
+      mul *= mul;
+    }
+    state = acc_mul * state + acc_add;
+  }
+
+  friend bool operator==(const pcg32 &lhs, const pcg32 &rhs) {
+    return lhs.state == rhs.state && lhs.increment == rhs.increment;
+  }
+
+  friend bool operator!=(const pcg32 &lhs, const pcg32 &rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+/**
+ * @brief Get a seed which differs from call to call and from run to run.
+ *
+ * @return std::uint64_t The seed, mixing `std::random_device`, the clock and
+ * the calling thread.
+ */
+inline std::uint64_t random_seed() {
+  std::random_device device;
+  std::uint64_t seed = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+  seed ^= static_cast<std::uint64_t>(
+      std::chrono::high_resolution_clock::now().time_since_epoch().count());
+  seed ^= std::hash<std::thread::id>()(std::this_thread::get_id()) *
+          0x9E3779B97F4A7C15ull;
+  return splitmix64(seed)();
+}
+
+/**
+ * @brief Get the engine owned by the calling thread, seeded by `random_seed`
+ * on first use.
+ * @note No lock is taken, unlike `rand()`.
+ *
+ * @return xoshiro256starstar& The engine.
+ */
+inline xoshiro256starstar &thread_random_engine() {
+  thread_local xoshiro256starstar engine(tiny_stl::random_seed());
+  return engine;
+}
+
+/**
+ * @brief Generate a uniform integer in `[0, range)` by Lemire's nearly
+ * divisionless method: a random fraction of `range` is taken by a widening
+ * multiplication, and only the rare draws falling in the biased low part
+ * compute a remainder to be rejected.
+ *
+ * @tparam URBG The type of the engine.
+ * @param g The engine.
+ * @param range The number of possible results, at least 1.
+ * @return std::uint64_t The integer.
+ */
+template <class URBG>
+std::uint64_t uniform_bounded(URBG &g, std::uint64_t range) {
+  constexpr auto min_value = static_cast<std::uint64_t>(URBG::min());
+  constexpr auto max_value = static_cast<std::uint64_t>(URBG::max());
+  if constexpr (min_value == 0 &&
+                max_value == std::numeric_limits<std::uint64_t>::max()) {
+    auto m = static_cast<unsigned __int128>(static_cast<std::uint64_t>(g())) *
+             range;
+    auto low = static_cast<std::uint64_t>(m);
+    if (low < range) {
+      const std::uint64_t threshold = (0 - range) % range;
+      while (low < threshold) {
+        m = static_cast<unsigned __int128>(static_cast<std::uint64_t>(g())) *
+            range;
+        low = static_cast<std::uint64_t>(m);
+      }
+    }
+    return static_cast<std::uint64_t>(m >> 64);
+  } else if constexpr (min_value == 0 &&
+                       max_value == std::numeric_limits<std::uint32_t>::max()) {
+    if (range > max_value) {
+      // Two draws make one 64-bit draw.
+      struct wide {
+        URBG &g;
+        using result_type = std::uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() {
+          return std::numeric_limits<std::uint64_t>::max();
+        }
+        result_type operator()() {
+          const auto high = static_cast<std::uint64_t>(g());
+          return (high << 32) | static_cast<std::uint64_t>(g());
+        }
+      } w{g};
+      return tiny_stl::uniform_bounded(w, range);
+    }
+    const auto range32 = static_cast<std::uint32_t>(range);
+    std::uint64_t m = static_cast<std::uint64_t>(
+                          static_cast<std::uint32_t>(g())) *
+                      range32;
+    auto low = static_cast<std::uint32_t>(m);
+    if (low < range32) {
+      const std::uint32_t threshold = (0u - range32) % range32;
+      while (low < threshold) {
+        m = static_cast<std::uint64_t>(static_cast<std::uint32_t>(g())) *
+            range32;
+        low = static_cast<std::uint32_t>(m);
+      }
+    }
+    return m >> 32;
+  } else {
+    return std::uniform_int_distribution<std::uint64_t>(0, range - 1)(g);
+  }
+}
+
+/**
+ * @brief Generate a uniform real number in `(0, 1)`, neither end included, so
+ * its logarithm is always finite.
+ *
+ * @tparam URBG The type of the engine.
+ * @param g The engine.
+ * @return double The number, a multiple of `2^-53` plus `2^-54`.
+ */
+template <class URBG> double uniform_unit(URBG &g) {
+  const std::uint64_t bits =
+      tiny_stl::uniform_bounded(g, std::uint64_t(1) << 53);
+  return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+}
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__RANDOM_HPP
@@ -0,0 +1,321 @@
+/**
+ * @file search_index.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains a read-only index answering binary searches over
+ * a sorted table.
+ *
+ * @details `tiny_stl::lower_bound` on a large sorted array misses the cache
+ * on almost every probe, because the probes of a binary search are far apart
+ * in memory until the last few steps. When a table is built once and searched
+ * many times, its keys can be re-laid in an order where each probe loads a
+ * whole cache line of useful keys. This file contains the following
+ * utilities:
+ * - `search_index_rank`: count the keys of a node before a value, with vector
+ * compares where available.
+ * - `static_search_index`: the keys of a sorted range laid out as an implicit
+ * static B-tree whose nodes are one cache line each.
+ */
+#ifndef TINY_STL__INCLUDE__SEARCH_INDEX_HPP
+#define TINY_STL__INCLUDE__SEARCH_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace tiny_stl {
+
+/**
+ * @brief The size of a node of `static_search_index` in bytes, one cache line.
+ */
+constexpr std::size_t kSearchIndexNodeBytes = 64;
+
+/**
+ * @brief The type the keys of `static_search_index<T>` are stored as.
+ * @note Unsigned keys are stored as signed ones with the sign bit flipped,
+ * which keeps their order and lets them use the signed vector compares.
+ */
+template <class T>
+using search_index_key_t =
+    typename std::conditional_t<std::is_unsigned_v<T>, std::make_signed<T>,
+                                std::remove_cv<T>>::type;
+
+/**
+ * @brief Whether the nodes of keys of type `Key` are searched with vector
+ * compares.
+ */
+template <class Key>
+inline constexpr bool is_simd_index_key_v =
+#if defined(__AVX2__)
+    std::is_same_v<Key, std::int64_t> ||
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+    std::is_same_v<Key, std::int32_t> || std::is_same_v<Key, float> ||
+    std::is_same_v<Key, double> ||
+#endif
+    false;
+
+/**
+ * @brief Count the keys of a sorted node which come before a value.
+ *
+ * @tparam Upper Whether the keys equal to the value come before it, that is,
+ * whether the count is the `upper_bound` rather than the `lower_bound` of the
+ * value in the node.
+ * @tparam Key The type of the keys.
+ * @tparam N The number of keys in the node.
+ * @param node The keys, sorted, aligned to `kSearchIndexNodeBytes`.
+ * @param value The value.
+ * @return std::size_t The number of keys before the value, in `[0, N]`.
+ */
+template <bool Upper, class Key, std::size_t N>
+inline std::size_t search_index_rank(const Key (&node)[N], Key value) noexcept {
+  if constexpr (is_simd_index_key_v<Key>) {
+    // The lanes at and after the rank are set in `stop`, the rank is the
+    // number of trailing zeros.
+    std::uint32_t stop = 0;
+#if defined(__AVX2__)
+    constexpr std::size_t kLanes = 32 / sizeof(Key);
+    const auto *data = reinterpret_cast<const __m256i *>(node);
+    for (std::size_t j = 0; j < N / kLanes; ++j) {
+      std::uint32_t mask = 0;
+      if constexpr (std::is_same_v<Key, std::int32_t>) {
+        const __m256i keys = _mm256_load_si256(data + j);
+        const __m256i v = _mm256_set1_epi32(value);
+        mask = static_cast<std::uint32_t>(_mm256_movemask_ps(
+            _mm256_castsi256_ps(Upper ? _mm256_cmpgt_epi32(keys, v)
+                                      : _mm256_cmpgt_epi32(v, keys))));
+      } else if constexpr (std::is_same_v<Key, std::int64_t>) {
+        const __m256i keys = _mm256_load_si256(data + j);
+        const __m256i v = _mm256_set1_epi64x(value);
+        mask = static_cast<std::uint32_t>(_mm256_movemask_pd(
+            _mm256_castsi256_pd(Upper ? _mm256_cmpgt_epi64(keys, v)
+                                      : _mm256_cmpgt_epi64(v, keys))));
+      } else if constexpr (std::is_same_v<Key, float>) {
+        const __m256 keys = _mm256_load_ps(node + j * kLanes);
+        const __m256 v = _mm256_set1_ps(value);
+        mask = static_cast<std::uint32_t>(_mm256_movemask_ps(
+            Upper ? _mm256_cmp_ps(keys, v, _CMP_GT_OQ)
+                  : _mm256_cmp_ps(keys, v, _CMP_LT_OQ)));
+      } else {
+        const __m256d keys = _mm256_load_pd(node + j * kLanes);
+        const __m256d v = _mm256_set1_pd(value);
+        mask = static_cast<std::uint32_t>(_mm256_movemask_pd(
+            Upper ? _mm256_cmp_pd(keys, v, _CMP_GT_OQ)
+                  : _mm256_cmp_pd(keys, v, _CMP_LT_OQ)));
+      }
+      stop |= mask << (j * kLanes);
+    }
+#elif defined(__SSE2__)
+    constexpr std::size_t kLanes = 16 / sizeof(Key);
+    const auto *data = reinterpret_cast<const __m128i *>(node);
+    for (std::size_t j = 0; j < N / kLanes; ++j) {
+      std::uint32_t mask = 0;
+      if constexpr (std::is_same_v<Key, std::int32_t>) {
+        const __m128i keys = _mm_load_si128(data + j);
+        const __m128i v = _mm_set1_epi32(value);
+        mask = static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(
+            Upper ? _mm_cmpgt_epi32(keys, v) : _mm_cmplt_epi32(keys, v))));
+      } else if constexpr (std::is_same_v<Key, float>) {
+        const __m128 keys = _mm_load_ps(node + j * kLanes);
+        const __m128 v = _mm_set1_ps(value);
+        mask = static_cast<std::uint32_t>(_mm_movemask_ps(
+            Upper ? _mm_cmpgt_ps(keys, v) : _mm_cmplt_ps(keys, v)));
+      } else {
+        const __m128d keys = _mm_load_pd(node + j * kLanes);
+        const __m128d v = _mm_set1_pd(value);
+        mask = static_cast<std::uint32_t>(_mm_movemask_pd(
+            Upper ? _mm_cmpgt_pd(keys, v) : _mm_cmplt_pd(keys, v)));
+      }
+      stop |= mask << (j * kLanes);
+    }
+#endif
+    if constexpr (!Upper)
+      stop = ~stop;
+    return static_cast<std::size_t>(__builtin_ctz(stop | (1u << N)));
+  } else {
+    std::size_t rank = 0;
+    for (std::size_t i = 0; i < N; ++i)
+      rank += Upper ? !(value < node[i]) : node[i] < value;
+    return rank;
+  }
+}
+
+/**
+ * @brief A read-only index over a sorted range, answering `lower_bound`,
+ * `upper_bound` and `contains` with the positions in the range.
+ *
+ * @details The keys are laid out as an implicit static B-tree: every node
+ * holds one cache line of keys, and the children of node `k` are the nodes
+ * `k * (B + 1) + 1` to `k * (B + 1) + B + 1`, so no pointers are stored. A
+ * search loads one node per level, `log(n) / log(B + 1)` nodes in all, and
+ * finds its way inside a node with vector compares instead of branches. With
+ * 4-byte keys this is about 4 cache misses for a million keys, against about
+ * 20 probes of a binary search of which the first dozen miss.
+ *
+ * @tparam T The type of the keys, which must be arithmetic.
+ * @note The positions are kept aside and only read once per search, so the
+ * index takes about `n * (sizeof(T) + sizeof(size_t))` bytes.
+ */
+template <class T> class static_search_index {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "static_search_index needs an arithmetic key type");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  using key_type = search_index_key_t<T>;
+
+  static constexpr size_type kNodeSize =
+      kSearchIndexNodeBytes / sizeof(key_type);
+
+  struct alignas(kSearchIndexNodeBytes) node {
+    key_type keys[kNodeSize];
+  };
+
+  std::vector<node> nodes;
+  // The position in the sorted range of every slot of `nodes`, `count` for
+  // the padding after the last key.
+  std::vector<size_type> positions;
+  size_type count = 0;
+
+  static key_type to_key(T value) noexcept {
+    if constexpr (std::is_unsigned_v<T>) {
+      constexpr T sign = T(1) << (std::numeric_limits<T>::digits - 1);
+      return static_cast<key_type>(static_cast<T>(value ^ sign));
+    } else {
+      return value;
+    }
+  }
+
+  static constexpr key_type padding() noexcept {
+    if constexpr (std::numeric_limits<key_type>::has_infinity)
+      return std::numeric_limits<key_type>::infinity();
+    else
+      return std::numeric_limits<key_type>::max();
+  }
+
+  static size_type child(size_type k, size_type i) noexcept {
+    return k * (kNodeSize + 1) + i + 1;
+  }
+
+  // Fill the subtree of node `k` in order from `sorted[next]` on.
+  void build(size_type k, const std::vector<key_type> &sorted,
+             size_type &next) {
+    if (k >= nodes.size())
+      return;
+    for (size_type i = 0; i < kNodeSize; ++i) {
+      build(child(k, i), sorted, next);
+      const bool padded = next >= count;
+      nodes[k].keys[i] = padded ? padding() : sorted[next];
+      positions[k * kNodeSize + i] = padded ? count : next++;
+    }
+    build(child(k, kNodeSize), sorted, next);
+  }
+
+  // The slot of the first key after `value` (Upper) or not before it, or
+  // the number of slots if there is none.
+  template <bool Upper> size_type find_slot(T value) const noexcept {
+    const key_type key = to_key(value);
+    const size_type node_count = nodes.size();
+    size_type slot = node_count * kNodeSize;
+    size_type k = 0;
+    while (k < node_count) {
+      const size_type rank =
+          tiny_stl::search_index_rank<Upper>(nodes[k].keys, key);
+      slot = rank < kNodeSize ? k * kNodeSize + rank : slot;
+      k = child(k, rank);
+    }
+    return slot;
+  }
+
+  size_type position(size_type slot) const noexcept {
+    return slot < positions.size() ? positions[slot] : count;
+  }
+
+public:
+  /**
+   * @brief Construct an empty index.
+   */
+  static_search_index() = default;
+
+  /**
+   * @brief Construct an index over a sorted range.
+   * @pre The range is sorted by `operator<` and holds no NaN.
+   *
+   * @tparam InputIter The type of the iterator of the range.
+   * @param first The beginning of the range.
+   * @param last The end of the range.
+   */
+  template <class InputIter>
+  static_search_index(InputIter first, InputIter last) {
+    std::vector<key_type> sorted;
+    for (; first != last; ++first)
+      sorted.push_back(to_key(*first));
+    count = sorted.size();
+    nodes.resize((count + kNodeSize - 1) / kNodeSize);
+    positions.resize(nodes.size() * kNodeSize);
+    size_type next = 0;
+    build(0, sorted, next);
+  }
+
+  /**
+   * @brief Get the number of keys.
+   *
+   * @return size_type The number of keys.
+   */
+  size_type size() const noexcept { return count; }
+
+  /**
+   * @brief Check whether the index has no key.
+   *
+   * @return true The index has no key.
+   * @return false The index has some keys.
+   */
+  bool empty() const noexcept { return count == 0; }
+
+  /**
+   * @brief Find the first key not less than a value.
+   *
+   * @param value The value.
+   * @return size_type The position of the key in the sorted range, `size()`
+   * if there is none.
+   */
+  size_type lower_bound(T value) const noexcept {
+    return position(find_slot<false>(value));
+  }
+
+  /**
+   * @brief Find the first key greater than a value.
+   *
+   * @param value The value.
+   * @return size_type The position of the key in the sorted range, `size()`
+   * if there is none.
+   */
+  size_type upper_bound(T value) const noexcept {
+    return position(find_slot<true>(value));
+  }
+
+  /**
+   * @brief Check whether a key equals a value.
+   *
+   * @param value The value.
+   * @return true Some key equals the value.
+   * @return false No key equals the value.
+   */
+  bool contains(T value) const noexcept {
+    const size_type slot = find_slot<false>(value);
+    return position(slot) != count &&
+           nodes[slot / kNodeSize].keys[slot % kNodeSize] == to_key(value);
+  }
+};
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__SEARCH_INDEX_HPP
@@ -0,0 +1,761 @@
+/**
+ * @file searcher.hpp
+ * @author Liu Yuan (2787141886@qq.com)
+ * @brief This file contains the searchers used by `tiny_stl::search`.
+ *
+ * @details A searcher is built once from a pattern, and then finds the pattern
+ * in any number of texts by `searcher(first, last)`, which returns the range
+ * of the first occurrence, or `(last, last)` if there is none. This file
+ * contains the following utilities:
+ * - `default_searcher`: compare the pattern at every position of the text.
+ * - `boyer_moore_horspool_searcher`: skip by the bad character rule on the
+ * last element of the window.
+ * - `boyer_moore_searcher`: skip by both the bad character rule and the good
+ * suffix rule.
+ * - `two_way_searcher`: the two-way algorithm, linear time and constant extra
+ * space, for ordered element types.
+ * - `byte_searcher`: filter the positions of a byte text by the first and the
+ * last byte of the pattern with vector compares.
+ * - `search_bytes`: find a byte pattern in a byte text, choosing the engine by
+ * the length of the pattern.
+ */
+#ifndef TINY_STL__INCLUDE__SEARCHER_HPP
+#define TINY_STL__INCLUDE__SEARCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+
+namespace tiny_stl {
+
+/**
+ * @brief The naive searcher, which compares the pattern at every position of
+ * the text, in `O(n * m)` time.
+ *
+ * @tparam ForwardIter1 The type of the iterator of the pattern.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart.
+ */
+template <class ForwardIter1,
+          class BinaryPred = tiny_stl::equal_to<
+              typename iterator_traits<ForwardIter1>::value_type>>
+class default_searcher {
+private:
+  ForwardIter1 pattern_first;
+  ForwardIter1 pattern_last;
+  BinaryPred pred;
+
+public:
+  /**
+   * @brief Construct a new default searcher.
+   * @warning The pattern is not copied, it must outlive the searcher.
+   *
+   * @param first The beginning of the pattern.
+   * @param last The end of the pattern.
+   * @param pred The predicate telling equal elements apart.
+   */
+  default_searcher(ForwardIter1 first, ForwardIter1 last,
+                   BinaryPred pred = BinaryPred())
+      : pattern_first(first), pattern_last(last), pred(pred) {}
+
+  /**
+   * @brief Find the pattern in a text.
+   *
+   * @tparam ForwardIter2 The type of the iterator of the text.
+   * @param first The beginning of the text.
+   * @param last The end of the text.
+   * @return tiny_stl::pair<ForwardIter2, ForwardIter2> The range of the first
+   * occurrence, `(last, last)` if there is none.
+   */
+  template <class ForwardIter2>
+  tiny_stl::pair<ForwardIter2, ForwardIter2>
+  operator()(ForwardIter2 first, ForwardIter2 last) const {
+    for (;; ++first) {
+      auto text = first;
+      auto pattern = pattern_first;
+      for (;; ++text, ++pattern) {
+        if (pattern == pattern_last)
+          return tiny_stl::pair<ForwardIter2, ForwardIter2>(first, text);
+        if (text == last)
+          return tiny_stl::pair<ForwardIter2, ForwardIter2>(last, last);
+        if (!pred(*pattern, *text))
+          break;
+      }
+    }
+  }
+};
+
+/**
+ * @brief Check if the elements of type `Key` compared by `BinaryPred` can
+ * index a table of 256 entries, i.e. they are bytes compared by `==`.
+ *
+ * @tparam Key The type of the element.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart.
+ */
+template <class Key, class BinaryPred>
+inline constexpr bool is_byte_table_key_v =
+    std::is_integral_v<Key> && sizeof(Key) == 1 &&
+    !std::is_same_v<Key, bool> &&
+    std::is_same_v<BinaryPred, tiny_stl::equal_to<Key>>;
+
+/**
+ * @brief The table mapping an element to its shift in the Boyer-Moore
+ * searchers.
+ *
+ * @details The table is an open-addressing hash table with linear probing. A
+ * slot keeps the position in the pattern of its key instead of a copy, so the
+ * lookups need the pattern.
+ *
+ * @tparam RandomIter The type of the iterator of the pattern.
+ * @tparam Hash The type of the hash function.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart.
+ * @tparam Bytes Whether the elements are bytes, the table is a plain array
+ * then.
+ */
+template <class RandomIter, class Hash, class BinaryPred,
+          bool Bytes = is_byte_table_key_v<
+              typename iterator_traits<RandomIter>::value_type, BinaryPred>>
+class searcher_skip_table {
+public:
+  using difference_type =
+      typename iterator_traits<RandomIter>::difference_type;
+
+private:
+  struct slot {
+    difference_type index; // The position of the key in the pattern, or -1.
+    difference_type value; // The shift of the key.
+  };
+
+  std::vector<slot> slots;
+  size_t shift;
+  Hash hash;
+  BinaryPred pred;
+
+public:
+  /**
+   * @brief Construct a new skip table, in which every element maps to
+   * `default_value`.
+   *
+   * @param size The number of keys which will be set.
+   * @param default_value The value of the elements never set.
+   * @param hash The hash function.
+   * @param pred The predicate telling equal elements apart.
+   */
+  searcher_skip_table(size_t size, difference_type default_value, Hash hash,
+                      BinaryPred pred)
+      : shift(64 - 3), hash(hash), pred(pred) {
+    size_t capacity = 8;
+    while (capacity < size * 2) {
+      capacity *= 2;
+      --shift;
+    }
+    slots.assign(capacity, slot{-1, default_value});
+  }
+
+  /**
+   * @brief Map the element at `pattern[index]` to `value`.
+   *
+   * @param pattern The beginning of the pattern.
+   * @param index The position of the element in the pattern.
+   * @param value The value.
+   */
+  void set(RandomIter pattern, difference_type index, difference_type value) {
+    slot &target = slots[find_slot(pattern[index], pattern)];
+    target.index = index;
+    target.value = value;
+  }
+
+  /**
+   * @brief Get the value of an element.
+   *
+   * @tparam T The type of the element.
+   * @param key The element.
+   * @param pattern The beginning of the pattern.
+   * @return difference_type The value, `default_value` if it was never set.
+   */
+  template <class T>
+  difference_type get(const T &key, RandomIter pattern) const {
+    return slots[find_slot(key, pattern)].value;
+  }
+
+private:
+  /**
+   * @brief Find the slot holding `key`, or the empty slot where it would be
+   * inserted.
+   */
+  template <class T>
+  size_t find_slot(const T &key, RandomIter pattern) const {
+    const size_t mask = slots.size() - 1;
+    // Fibonacci hashing spreads the identity hashes of the built-in types.
+    size_t i = static_cast<size_t>(
+        (static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull) >>
+        shift);
+    while (slots[i].index != -1 && !pred(pattern[slots[i].index], key)) {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+};
+
+/**
+ * @brief The skip table of byte elements, which is a plain array.
+ *
+ * @tparam RandomIter The type of the iterator of the pattern.
+ * @tparam Hash The type of the hash function, unused.
+ * @tparam BinaryPred The type of the predicate, `equal_to`.
+ */
+template <class RandomIter, class Hash, class BinaryPred>
+class searcher_skip_table<RandomIter, Hash, BinaryPred, true> {
+public:
+  using difference_type =
+      typename iterator_traits<RandomIter>::difference_type;
+
+private:
+  difference_type table[256];
+
+public:
+  searcher_skip_table(size_t, difference_type default_value, Hash,
+                      BinaryPred) {
+    for (auto &value : table) {
+      value = default_value;
+    }
+  }
+
+  void set(RandomIter pattern, difference_type index, difference_type value) {
+    table[static_cast<unsigned char>(pattern[index])] = value;
+  }
+
+  template <class T>
+  difference_type get(const T &key, RandomIter) const {
+    return table[static_cast<unsigned char>(key)];
+  }
+};
+
+/**
+ * @brief The Boyer-Moore-Horspool searcher. The window slides by the distance
+ * from the last occurrence of its last element in the pattern to the end of
+ * the pattern, which is sublinear on average for large alphabets.
+ *
+ * @tparam RandomIter1 The type of the iterator of the pattern.
+ * @tparam Hash The type of the hash function of the elements.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart,
+ * equal elements must have the same hash.
+ */
+template <class RandomIter1,
+          class Hash =
+              tiny_stl::hash<typename iterator_traits<RandomIter1>::value_type>,
+          class BinaryPred = tiny_stl::equal_to<
+              typename iterator_traits<RandomIter1>::value_type>>
+class boyer_moore_horspool_searcher {
+private:
+  using table_type = searcher_skip_table<RandomIter1, Hash, BinaryPred>;
+  using difference_type = typename table_type::difference_type;
+
+  RandomIter1 pattern_first;
+  difference_type pattern_size;
+  table_type skip;
+  BinaryPred pred;
+
+public:
+  /**
+   * @brief Construct a new Boyer-Moore-Horspool searcher.
+   * @warning The pattern is not copied, it must outlive the searcher.
+   *
+   * @param first The beginning of the pattern.
+   * @param last The end of the pattern.
+   * @param hash The hash function of the elements.
+   * @param pred The predicate telling equal elements apart.
+   */
+  boyer_moore_horspool_searcher(RandomIter1 first, RandomIter1 last,
+                                Hash hash = Hash(),
+                                BinaryPred pred = BinaryPred())
+      : pattern_first(first), pattern_size(last - first),
+        skip(static_cast<size_t>(last - first), last - first, hash, pred),
+        pred(pred) {
+    for (difference_type i = 0; i + 1 < pattern_size; ++i) {
+      skip.set(pattern_first, i, pattern_size - 1 - i);
+    }
+  }
+
+  /**
+   * @brief Find the pattern in a text.
+   *
+   * @tparam RandomIter2 The type of the iterator of the text.
+   * @param first The beginning of the text.
+   * @param last The end of the text.
+   * @return tiny_stl::pair<RandomIter2, RandomIter2> The range of the first
+   * occurrence, `(last, last)` if there is none.
+   */
+  template <class RandomIter2>
+  tiny_stl::pair<RandomIter2, RandomIter2> operator()(RandomIter2 first,
+                                                      RandomIter2 last) const {
+    using result_type = tiny_stl::pair<RandomIter2, RandomIter2>;
+    if (pattern_size == 0)
+      return result_type(first, first);
+    const auto n = static_cast<difference_type>(last - first);
+    for (difference_type pos = 0; pos + pattern_size <= n;) {
+      difference_type j = pattern_size - 1;
+      while (pred(pattern_first[j], first[pos + j])) {
+        if (j == 0)
+          return result_type(first + pos, first + pos + pattern_size);
+        --j;
+      }
+      pos += skip.get(first[pos + pattern_size - 1], pattern_first);
+    }
+    return result_type(last, last);
+  }
+};
+
+/**
+ * @brief The Boyer-Moore searcher. On a mismatch, the window slides by the
+ * larger of the bad character shift and the good suffix shift, the latter
+ * aligns the matched suffix with its previous occurrence in the pattern.
+ *
+ * @tparam RandomIter1 The type of the iterator of the pattern.
+ * @tparam Hash The type of the hash function of the elements.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart,
+ * equal elements must have the same hash.
+ */
+template <class RandomIter1,
+          class Hash =
+              tiny_stl::hash<typename iterator_traits<RandomIter1>::value_type>,
+          class BinaryPred = tiny_stl::equal_to<
+              typename iterator_traits<RandomIter1>::value_type>>
+class boyer_moore_searcher {
+private:
+  using table_type = searcher_skip_table<RandomIter1, Hash, BinaryPred>;
+  using difference_type = typename table_type::difference_type;
+
+  RandomIter1 pattern_first;
+  difference_type pattern_size;
+  table_type bad_char;
+  std::vector<difference_type> good_suffix;
+  BinaryPred pred;
+
+public:
+  /**
+   * @brief Construct a new Boyer-Moore searcher.
+   * @warning The pattern is not copied, it must outlive the searcher.
+   *
+   * @param first The beginning of the pattern.
+   * @param last The end of the pattern.
+   * @param hash The hash function of the elements.
+   * @param pred The predicate telling equal elements apart.
+   */
+  boyer_moore_searcher(RandomIter1 first, RandomIter1 last, Hash hash = Hash(),
+                       BinaryPred pred = BinaryPred())
+      : pattern_first(first), pattern_size(last - first),
+        bad_char(static_cast<size_t>(last - first), last - first, hash, pred),
+        good_suffix(static_cast<size_t>(last - first)), pred(pred) {
+    for (difference_type i = 0; i + 1 < pattern_size; ++i) {
+      bad_char.set(pattern_first, i, pattern_size - 1 - i);
+    }
+    build_good_suffix();
+  }
+
+  /**
+   * @brief Find the pattern in a text.
+   *
+   * @tparam RandomIter2 The type of the iterator of the text.
+   * @param first The beginning of the text.
+   * @param last The end of the text.
+   * @return tiny_stl::pair<RandomIter2, RandomIter2> The range of the first
+   * occurrence, `(last, last)` if there is none.
+   */
+  template <class RandomIter2>
+  tiny_stl::pair<RandomIter2, RandomIter2> operator()(RandomIter2 first,
+                                                      RandomIter2 last) const {
+    using result_type = tiny_stl::pair<RandomIter2, RandomIter2>;
+    if (pattern_size == 0)
+      return result_type(first, first);
+    const auto n = static_cast<difference_type>(last - first);
+    for (difference_type pos = 0; pos + pattern_size <= n;) {
+      difference_type j = pattern_size - 1;
+      while (j >= 0 && pred(pattern_first[j], first[pos + j])) {
+        --j;
+      }
+      if (j < 0)
+        return result_type(first + pos, first + pos + pattern_size);
+      const difference_type bad =
+          bad_char.get(first[pos + j], pattern_first) - pattern_size + 1 + j;
+      const difference_type good = good_suffix[static_cast<size_t>(j)];
+      pos += bad > good ? bad : good;
+    }
+    return result_type(last, last);
+  }
+
+private:
+  /**
+   * @brief Compute the good suffix shifts, `good_suffix[j]` is the shift when
+   * the element at `j` mismatches after the elements behind it matched.
+   */
+  void build_good_suffix() {
+    const difference_type m = pattern_size;
+    if (m == 0)
+      return;
+    // suffix[i] is the length of the longest common suffix of the pattern and
+    // the prefix of the pattern ending at `i`.
+    std::vector<difference_type> suffix(static_cast<size_t>(m));
+    suffix[m - 1] = m;
+    difference_type g = m - 1;
+    difference_type f = 0;
+    for (difference_type i = m - 2; i >= 0; --i) {
+      if (i > g && suffix[i + m - 1 - f] < i - g) {
+        suffix[i] = suffix[i + m - 1 - f];
+      } else {
+        if (i < g)
+          g = i;
+        f = i;
+        while (g >= 0 && pred(pattern_first[g], pattern_first[g + m - 1 - f]))
+          --g;
+        suffix[i] = f - g;
+      }
+    }
+
+    for (auto &shift : good_suffix) {
+      shift = m;
+    }
+    difference_type j = 0;
+    for (difference_type i = m - 1; i >= 0; --i) {
+      if (suffix[i] == i + 1) {
+        for (; j < m - 1 - i; ++j) {
+          if (good_suffix[j] == m)
+            good_suffix[j] = m - 1 - i;
+        }
+      }
+    }
+    for (difference_type i = 0; i + 1 < m; ++i) {
+      good_suffix[m - 1 - suffix[i]] = m - 1 - i;
+    }
+  }
+};
+
+/**
+ * @brief The two-way searcher, which splits the pattern at a critical
+ * factorization, matches the right part from left to right and then the left
+ * part from right to left, in `O(n + m)` time and constant extra space.
+ * @note The elements must be totally ordered by `Compare`, which is only used
+ * to factorize the pattern.
+ *
+ * @tparam RandomIter1 The type of the iterator of the pattern.
+ * @tparam BinaryPred The type of the predicate telling equal elements apart.
+ * @tparam Compare The type of the order of the elements.
+ */
+template <class RandomIter1,
+          class BinaryPred = tiny_stl::equal_to<
+              typename iterator_traits<RandomIter1>::value_type>,
+          class Compare =
+              tiny_stl::less<typename iterator_traits<RandomIter1>::value_type>>
+class two_way_searcher {
+private:
+  using difference_type =
+      typename iterator_traits<RandomIter1>::difference_type;
+
+  RandomIter1 pattern_first;
+  difference_type pattern_size;
+  difference_type critical; // The last position of the left part.
+  difference_type period;   // The shift after a full match of the right part.
+  bool periodic;            // Whether `period` is the period of the pattern.
+  BinaryPred pred;
+
+public:
+  /**
+   * @brief Construct a new two-way searcher.
+   * @warning The pattern is not copied, it must outlive the searcher.
+   *
+   * @param first The beginning of the pattern.
+   * @param last The end of the pattern.
+   * @param pred The predicate telling equal elements apart.
+   * @param comp The order of the elements.
+   */
+  two_way_searcher(RandomIter1 first, RandomIter1 last,
+                   BinaryPred pred = BinaryPred(), Compare comp = Compare())
+      : pattern_first(first), pattern_size(last - first), critical(-1),
+        period(1), periodic(false), pred(pred) {
+    if (pattern_size == 0)
+      return;
+    difference_type p = 0;
+    difference_type q = 0;
+    const difference_type i = maximal_suffix(comp, false, p);
+    const difference_type j = maximal_suffix(comp, true, q);
+    if (i > j) {
+      critical = i;
+      period = p;
+    } else {
+      critical = j;
+      period = q;
+    }
+    periodic = true;
+    for (difference_type k = 0; k <= critical; ++k) {
+      if (!pred(pattern_first[k], pattern_first[k + period])) {
+        periodic = false;
+        break;
+      }
+    }
+    if (!periodic) {
+      const difference_type left = critical + 1;
+      const difference_type right = pattern_size - critical - 1;
+      period = (left > right ? left : right) + 1;
+    }
+  }
+
+  /**
+   * @brief Find the pattern in a text.
+   *
+   * @tparam RandomIter2 The type of the iterator of the text.
+   * @param first The beginning of the text.
+   * @param last The end of the text.
+   * @return tiny_stl::pair<RandomIter2, RandomIter2> The range of the first
+   * occurrence, `(last, last)` if there is none.
+   */
+  template <class RandomIter2>
+  tiny_stl::pair<RandomIter2, RandomIter2> operator()(RandomIter2 first,
+                                                      RandomIter2 last) const {
+    using result_type = tiny_stl::pair<RandomIter2, RandomIter2>;
+    const difference_type m = pattern_size;
+    if (m == 0)
+      return result_type(first, first);
+    const auto n = static_cast<difference_type>(last - first);
+    const auto &x = pattern_first;
+    // The length of the prefix of the pattern known to match, periodic
+    // patterns only.
+    difference_type memory = -1;
+    for (difference_type pos = 0; pos + m <= n;) {
+      difference_type i = (critical > memory ? critical : memory) + 1;
+      while (i < m && pred(x[i], first[pos + i]))
+        ++i;
+      if (i < m) {
+        pos += i - critical;
+        memory = -1;
+        continue;
+      }
+      i = critical;
+      while (i > memory && pred(x[i], first[pos + i]))
+        --i;
+      if (i <= memory)
+        return result_type(first + pos, first + pos + m);
+      pos += period;
+      if (periodic)
+        memory = m - period - 1;
+    }
+    return result_type(last, last);
+  }
+
+private:
+  /**
+   * @brief Compute the maximal suffix of the pattern for the order, or for
+   * the reversed order.
+   *
+   * @param comp The order of the elements.
+   * @param reversed Whether to use the reversed order.
+   * @param period The period of the maximal suffix.
+   * @return difference_type The position before the maximal suffix.
+   */
+  difference_type maximal_suffix(Compare &comp, bool reversed,
+                                 difference_type &period) const {
+    const auto &x = pattern_first;
+    difference_type ms = -1;
+    difference_type j = 0;
+    difference_type k = 1;
+    period = 1;
+    while (j + k < pattern_size) {
+      const auto &a = x[j + k];
+      const auto &b = x[ms + k];
+      if (reversed ? comp(b, a) : comp(a, b)) {
+        j += k;
+        k = 1;
+        period = j - ms;
+      } else if (!comp(a, b) && !comp(b, a)) {
+        if (k != period) {
+          ++k;
+        } else {
+          j += period;
+          k = 1;
+        }
+      } else {
+        ms = j;
+        j = ms + 1;
+        k = period = 1;
+      }
+    }
+    return ms;
+  }
+};
+
+/**
+ * @brief Check if `T` is a byte type which `byte_searcher` can search.
+ *
+ * @tparam T The type of the element.
+ */
+template <class T>
+inline constexpr bool is_searchable_byte_v =
+    std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool>;
+
+/**
+ * @brief Find a byte pattern in a byte text by a vector filter: the positions
+ * whose first and last bytes match the pattern are found 16 (or 32 with AVX2)
+ * at a time, and only those are compared by `memcmp`.
+ *
+ * @param text The text.
+ * @param n The length of the text.
+ * @param pattern The pattern.
+ * @param m The length of the pattern, at least 2.
+ * @return size_t The position of the first occurrence, `n` if there is none.
+ */
+inline size_t filter_search_bytes(const unsigned char *text, size_t n,
+                                  const unsigned char *pattern,
+                                  size_t m) noexcept {
+  if (m > n)
+    return n;
+  size_t i = 0;
+  const unsigned char first_byte = pattern[0];
+  const unsigned char last_byte = pattern[m - 1];
+#if defined(__AVX2__)
+  const __m256i first_32 = _mm256_set1_epi8(static_cast<char>(first_byte));
+  const __m256i last_32 = _mm256_set1_epi8(static_cast<char>(last_byte));
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    const __m256i head =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+    const __m256i tail = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(text + i + m - 1));
+    auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(head, first_32), _mm256_cmpeq_epi8(tail, last_32))));
+    while (mask != 0) {
+      const auto bit = static_cast<size_t>(__builtin_ctz(mask));
+      if (std::memcmp(text + i + bit + 1, pattern + 1, m - 2) == 0)
+        return i + bit;
+      mask &= mask - 1;
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i first_16 = _mm_set1_epi8(static_cast<char>(first_byte));
+  const __m128i last_16 = _mm_set1_epi8(static_cast<char>(last_byte));
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    const __m128i head =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+    const __m128i tail =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + m - 1));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(head, first_16), _mm_cmpeq_epi8(tail, last_16))));
+    while (mask != 0) {
+      const auto bit = static_cast<size_t>(__builtin_ctz(mask));
+      if (std::memcmp(text + i + bit + 1, pattern + 1, m - 2) == 0)
+        return i + bit;
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i + m <= n; ++i) {
+    if (text[i] == first_byte && text[i + m - 1] == last_byte &&
+        std::memcmp(text + i + 1, pattern + 1, m - 2) == 0)
+      return i;
+  }
+  return n;
+}
+
+/**
+ * @brief Find a byte pattern in a byte text. An empty pattern is found at the
+ * beginning, a single byte is found by `memchr`, long patterns use
+ * Boyer-Moore-Horspool, whose shifts grow with the pattern, and the others
+ * use the vector filter.
+ *
+ * @param text The text.
+ * @param n The length of the text.
+ * @param pattern The pattern.
+ * @param m The length of the pattern.
+ * @return size_t The position of the first occurrence, `n` if there is none.
+ */
+inline size_t search_bytes(const unsigned char *text, size_t n,
+                           const unsigned char *pattern, size_t m) {
+  constexpr size_t kHorspoolPatternSize = 64;
+  if (m == 0)
+    return 0;
+  if (m > n)
+    return n;
+  if (m == 1) {
+    const void *hit = std::memchr(text, pattern[0], n);
+    return hit ? static_cast<size_t>(static_cast<const unsigned char *>(hit) -
+                                     text)
+               : n;
+  }
+#if defined(__SSE2__)
+  if (m < kHorspoolPatternSize)
+    return tiny_stl::filter_search_bytes(text, n, pattern, m);
+#endif
+  const boyer_moore_horspool_searcher<const unsigned char *> searcher(
+      pattern, pattern + m);
+  return static_cast<size_t>(searcher(text, text + n).first - text);
+}
+
+/**
+ * @brief The searcher of byte patterns in byte texts, see `search_bytes`.
+ *
+ * @tparam ContiguousIter1 The type of the iterator of the pattern, which must
+ * be contiguous over bytes.
+ */
+template <class ContiguousIter1> class byte_searcher {
+  static_assert(
+      tiny_stl::is_contiguous_iterator_v<ContiguousIter1> &&
+          is_searchable_byte_v<
+              typename iterator_traits<ContiguousIter1>::value_type>,
+      "byte_searcher needs a contiguous range of bytes");
+
+private:
+  const unsigned char *pattern;
+  size_t pattern_size;
+
+public:
+  /**
+   * @brief Construct a new byte searcher.
+   * @warning The pattern is not copied, it must outlive the searcher.
+   *
+   * @param first The beginning of the pattern.
+   * @param last The end of the pattern.
+   */
+  byte_searcher(ContiguousIter1 first, ContiguousIter1 last)
+      : pattern(reinterpret_cast<const unsigned char *>(
+            tiny_stl::to_address(first))),
+        pattern_size(static_cast<size_t>(last - first)) {}
+
+  /**
+   * @brief Find the pattern in a text.
+   *
+   * @tparam ContiguousIter2 The type of the iterator of the text, which must
+   * be contiguous over bytes.
+   * @param first The beginning of the text.
+   * @param last The end of the text.
+   * @return tiny_stl::pair<ContiguousIter2, ContiguousIter2> The range of the
+   * first occurrence, `(last, last)` if there is none.
+   */
+  template <class ContiguousIter2>
+  tiny_stl::pair<ContiguousIter2, ContiguousIter2>
+  operator()(ContiguousIter2 first, ContiguousIter2 last) const {
+    static_assert(
+        tiny_stl::is_contiguous_iterator_v<ContiguousIter2> &&
+            is_searchable_byte_v<
+                typename iterator_traits<ContiguousIter2>::value_type>,
+        "byte_searcher needs a contiguous range of bytes");
+    using result_type = tiny_stl::pair<ContiguousIter2, ContiguousIter2>;
+    const auto n = static_cast<size_t>(last - first);
+    const size_t pos = tiny_stl::search_bytes(
+        reinterpret_cast<const unsigned char *>(tiny_stl::to_address(first)),
+        n, pattern, pattern_size);
+    if (pos == n && pattern_size != 0)
+      return result_type(last, last);
+    return result_type(first + pos, first + pos + pattern_size);
+  }
+};
+
+} // namespace tiny_stl
+
+#endif // !TINY_STL__INCLUDE__SEARCHER_HPP
@@ -9,6 +9,8 @@
  * - `true_type`
  * - `false_type`
  * - `is_pair`
+ * - `is_zero_initializable`
+ * - `is_bitwise_comparable`
  */
 #ifndef TINY_STL__INCLUDE__TYPE_TRAITS_HPP
 #define TINY_STL__INCLUDE__TYPE_TRAITS_HPP
@@ -62,6 +64,79 @@ template <class T> struct is_pair : ::tiny_stl::false_type {};
 template <class T1, class T2>
 struct is_pair<::tiny_stl::pair<T1, T2>> : ::tiny_stl::true_type {};
 
+/**
+ * @brief Helper struct, judge if an object of the given type whose bytes are
+ * all zero is a valid object, so that it can be produced by `memset` or by
+ * memory which is zeroed already (e.g. `calloc`).
+ *
+ * @details Arithmetic types, enumerations and object pointers are
+ * zero-initializable. Pointers to members are not, since a null pointer to
+ * data member is not all-zero on some ABIs. Other trivially copyable types can
+ * opt in by specializing this struct:
+ * @code{.cpp}
+ * template <> struct tiny_stl::is_zero_initializable<Point> : tiny_stl::true_type {};
+ * @endcode
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+struct is_zero_initializable
+    : ::tiny_stl::compile_time_constant_bool<std::is_arithmetic_v<T> ||
+                                             std::is_enum_v<T> ||
+                                             std::is_pointer_v<T>> {};
+
+/**
+ * @brief `const` objects are zero-initializable if the non-`const` ones are.
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+struct is_zero_initializable<const T> : is_zero_initializable<T> {};
+
+/**
+ * @brief Helper variable template of `is_zero_initializable`.
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+inline constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+
+/**
+ * @brief Helper struct, judge if two objects of the given type are equal
+ * exactly when their bytes are equal, so that they can be compared by `memcmp`.
+ *
+ * @details Integers, enumerations and object pointers are bitwise comparable.
+ * Floating point types are not, since `0.0 == -0.0` and `NaN != NaN`. Other
+ * trivially copyable types without padding, whose `operator==` compares all the
+ * members, can opt in by specializing this struct:
+ * @code{.cpp}
+ * template <> struct tiny_stl::is_bitwise_comparable<Point> : tiny_stl::true_type {};
+ * @endcode
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+struct is_bitwise_comparable
+    : ::tiny_stl::compile_time_constant_bool<std::is_integral_v<T> ||
+                                             std::is_enum_v<T> ||
+                                             std::is_pointer_v<T>> {};
+
+/**
+ * @brief `const` objects are bitwise comparable if the non-`const` ones are.
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+struct is_bitwise_comparable<const T> : is_bitwise_comparable<T> {};
+
+/**
+ * @brief Helper variable template of `is_bitwise_comparable`.
+ *
+ * @tparam T The type to be judged
+ */
+template <class T>
+inline constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+
 } // namespace tiny_stl
 
 #endif // !TINY_STL__INCLUDE__TYPE_TRAITS_HP
\ No newline at end of file
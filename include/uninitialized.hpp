@@ -17,19 +17,48 @@
  * - `uninitialized_move`: move a range of objects to a raw memory.
  * - `unchecked_uninit_move_n`: move a range of objects to a raw memory.
  * - `uninitialized_move_n`: move a range of objects to a raw memory.
+ * - `uninitialized_relocate_move`: move a range of objects to a new buffer,
+ * huge trivial ranges are streamed past the cache.
+ * - `par_uninit_construct`: construct a range of objects in parallel chunks.
+ * - The overloads of the functions above taking an execution policy, which
+ * construct large random access ranges on the worker pool.
  */
 #ifndef TINY_STL__INCLUDE__UNINITIALIZAED_HPP
 #define TINY_STL__INCLUDE__UNINITIALIZAED_HPP
 
 #include "algobase.hpp"
 #include "construct.hpp"
+#include "execution.hpp"
 #include "iterator.hpp"
 #include "utility.hpp"
 
+#include <memory>
 #include <type_traits>
 
 namespace tiny_stl {
 
+/**
+ * @brief Check if copying a `T` into a raw memory can be done by assignment.
+ * @note Both the copy constructor and the copy assignment must be trivial, a
+ * user-provided copy constructor must not be skipped.
+ *
+ * @tparam T The type to be checked.
+ */
+template <class T>
+struct is_trivially_uninit_copyable
+    : std::integral_constant<bool, std::is_trivially_copy_constructible<T>::value &&
+                                       std::is_trivially_copy_assignable<T>::value> {};
+
+/**
+ * @brief Check if moving a `T` into a raw memory can be done by assignment.
+ *
+ * @tparam T The type to be checked.
+ */
+template <class T>
+struct is_trivially_uninit_moveable
+    : std::integral_constant<bool, std::is_trivially_move_constructible<T>::value &&
+                                       std::is_trivially_move_assignable<T>::value> {};
+
 /**
  * @brief Copy a range of trivially copy assignable objects to a raw memory.
  *
@@ -65,9 +94,8 @@ ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
       tiny_stl::construct(&(*cur), *first);
     }
   } catch (...) {
-    for (; cur != dest; --cur) {
-      tiny_stl::destroy(&(*cur));
-    }
+    tiny_stl::destroy(dest, cur);
+    throw;
   }
   return cur;
 }
@@ -87,7 +115,7 @@ ForwardIter uninitialized_copy(InputIter first, InputIter last,
                                ForwardIter dest) {
   return tiny_stl::unchecked_uninit_copy(
       first, last, dest,
-      std::is_trivially_copy_assignable<
+      tiny_stl::is_trivially_uninit_copyable<
           typename tiny_stl::iterator_traits<InputIter>::value_type>{});
 }
 
@@ -128,9 +156,8 @@ FowardIter unchecked_uninit_copy_n(InputIter first, Size n, FowardIter dest,
       tiny_stl::construct(&(*cur), *first);
     }
   } catch (...) {
-    for (; cur != dest; --cur) {
-      tiny_stl::destroy(&(*cur));
-    }
+    tiny_stl::destroy(dest, cur);
+    throw;
   }
   return cur;
 }
@@ -150,8 +177,8 @@ template <class InputIter, class Size, class FowardIter>
 FowardIter uninitialized_copy_n(InputIter first, Size n, FowardIter dest) {
   return tiny_stl::unchecked_uninit_copy_n(
       first, n, dest,
-      std::is_trivially_copy_constructible_v<
-          typename tiny_stl::iterator_traits<InputIter>::value_type>);
+      tiny_stl::is_trivially_uninit_copyable<
+          typename tiny_stl::iterator_traits<InputIter>::value_type>{});
 }
 
 /**
@@ -191,6 +218,7 @@ void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T &value,
   } catch (...) {
     for (; first != cur; ++first)
       tiny_stl::destroy(&*first);
+    throw;
   }
 }
 
@@ -208,8 +236,8 @@ template <class ForwardIter, class T>
 void uninitialized_fill(ForwardIter first, ForwardIter last, const T &value) {
   tiny_stl::unchecked_uninit_fill(
       first, last, value,
-      std::is_trivially_copy_assignable_v<
-          typename iterator_traits<ForwardIter>::value_type>);
+      tiny_stl::is_trivially_uninit_copyable<
+          typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 /**
@@ -251,6 +279,7 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T &value,
   } catch (...) {
     for (; first != cur; ++first)
       tiny_stl::destroy(&(*first));
+    throw;
   }
   return cur;
 }
@@ -270,8 +299,8 @@ template <class ForwardIter, class Size, class T>
 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T &value) {
   return tiny_stl::unchecked_uninit_fill_n(
       first, n, value,
-      std::is_trivially_copy_assignable_v<
-          typename iterator_traits<ForwardIter>::value_type>);
+      tiny_stl::is_trivially_uninit_copyable<
+          typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 /**
@@ -310,6 +339,7 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
     }
   } catch (...) {
     tiny_stl::destroy(dest, cur);
+    throw;
   }
   return cur;
 }
@@ -329,8 +359,8 @@ ForwardIter uninitialized_move(InputIter first, InputIter last,
                                ForwardIter dest) {
   return tiny_stl::unchecked_uninit_move(
       first, last, dest,
-      std::is_trivially_move_assignable_v<
-          typename iterator_traits<InputIter>::value_type>);
+      tiny_stl::is_trivially_uninit_moveable<
+          typename iterator_traits<InputIter>::value_type>{});
 }
 
 /**
@@ -392,8 +422,265 @@ template <class InputIter, class Size, class ForwardIter>
 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter dest) {
   return tiny_stl::unchecked_uninit_move_n(
       first, n, dest,
-      std::is_trivially_move_assignable_v<
-          typename iterator_traits<InputIter>::value_type>);
+      tiny_stl::is_trivially_uninit_moveable<
+          typename iterator_traits<InputIter>::value_type>{});
+}
+
+/**
+ * @brief Move a range of objects to a raw memory, used when a container moves
+ * its elements to a new buffer.
+ * @details Trivially movable ranges of at least `kStreamingCopyBytes` bytes are
+ * copied with non-temporal stores, so moving hundreds of megabytes does not
+ * evict the working set from the cache. Other ranges are moved by
+ * `uninitialized_move`.
+ * @warning The two ranges must not overlap.
+ *
+ * @tparam InputIter The type of the iterators.
+ * @tparam ForwardIter The type of the destination iterators.
+ * @param first The begin iterator of the source range.
+ * @param last The end iterator of the source range.
+ * @param dest The begin iterator of the destination range.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class InputIter, class ForwardIter>
+ForwardIter uninitialized_relocate_move(InputIter first, InputIter last,
+                                        ForwardIter dest) {
+  using value_type = typename iterator_traits<InputIter>::value_type;
+  if constexpr (std::is_pointer_v<InputIter> &&
+                std::is_pointer_v<ForwardIter> &&
+                tiny_stl::is_trivially_uninit_moveable<value_type>::value &&
+                std::is_trivially_copyable_v<value_type>) {
+    if (static_cast<size_t>(last - first) * sizeof(value_type) >=
+        tiny_stl::kStreamingCopyBytes) {
+      return tiny_stl::copy_nt(first, last, dest);
+    }
+  }
+  return tiny_stl::uninitialized_move(first, last, dest);
+}
+
+/**
+ * @brief Check if an algorithm called with the given execution policy and
+ * iterators should run in parallel, which requires `parallel_policy` and
+ * random access iterators.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam Iters The types of the iterators.
+ */
+template <class ExecutionPolicy, class... Iters>
+inline constexpr bool use_parallel_v =
+    std::is_same_v<std::remove_cv_t<std::remove_reference_t<ExecutionPolicy>>,
+                   tiny_stl::parallel_policy> &&
+    (tiny_stl::is_random_iterator<Iters>::value && ...);
+
+/**
+ * @brief Construct `n` objects on a raw memory in parallel chunks.
+ * @details The range is split into chunks of nearly equal size, one per
+ * worker, and each chunk is constructed by the thread which will usually touch
+ * it first, so the pages of the range are spread over the cores. A chunk which
+ * throws destroys the objects it has constructed; after all the chunks are
+ * finished, the objects of the chunks which succeeded are destroyed as well
+ * and the first exception is rethrown. So either all the `n` objects are
+ * constructed, or none of them is.
+ *
+ * @tparam ForwardIter The type of the destination iterators.
+ * @tparam Size The type of the size.
+ * @tparam ChunkConstruct The type of the function constructing a chunk.
+ * @param dest The begin iterator of the destination range.
+ * @param n The size of the destination range.
+ * @param construct_chunk The function called with `(begin, end)` to construct
+ * the objects of indexes `[begin, end)`, it must roll back on exception.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class ForwardIter, class Size, class ChunkConstruct>
+ForwardIter par_uninit_construct(ForwardIter dest, Size n,
+                                 ChunkConstruct construct_chunk) {
+  using value_type = typename iterator_traits<ForwardIter>::value_type;
+  const size_t total = n > 0 ? static_cast<size_t>(n) : 0;
+  const size_t chunks = tiny_stl::parallel_chunk_count(
+      total, tiny_stl::kParallelGrainBytes / sizeof(value_type));
+  if (chunks <= 1) {
+    construct_chunk(static_cast<size_t>(0), total);
+    return dest + total;
+  }
+  std::unique_ptr<bool[]> done(new bool[chunks]());
+  try {
+    tiny_stl::parallel_for(chunks, [&](size_t i) {
+      construct_chunk(tiny_stl::chunk_begin(total, chunks, i),
+                      tiny_stl::chunk_begin(total, chunks, i + 1));
+      done[i] = true;
+    });
+  } catch (...) {
+    for (size_t i = 0; i < chunks; ++i) {
+      if (done[i]) {
+        tiny_stl::destroy(dest + tiny_stl::chunk_begin(total, chunks, i),
+                          dest + tiny_stl::chunk_begin(total, chunks, i + 1));
+      }
+    }
+    throw;
+  }
+  return dest + total;
+}
+
+/**
+ * @brief Copy a range of objects to a raw memory with an execution policy.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam InputIter The type of the iterators.
+ * @tparam ForwardIter The type of the destination iterators.
+ * @param first The begin iterator of the source range.
+ * @param last The end iterator of the source range.
+ * @param dest The begin iterator of the destination range.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class ExecutionPolicy, class InputIter, class ForwardIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, ForwardIter>
+uninitialized_copy(ExecutionPolicy &&, InputIter first, InputIter last,
+                   ForwardIter dest) {
+  if constexpr (use_parallel_v<ExecutionPolicy, InputIter, ForwardIter>) {
+    return tiny_stl::par_uninit_construct(
+        dest, last - first, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_copy(first + begin, first + end,
+                                       dest + begin);
+        });
+  } else {
+    return tiny_stl::uninitialized_copy(first, last, dest);
+  }
+}
+
+/**
+ * @brief Copy a range of objects to a raw memory with an execution policy.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam InputIter The type of the iterators.
+ * @tparam Size The type of the size.
+ * @tparam ForwardIter The type of the destination iterators.
+ * @param first The begin iterator of the source range.
+ * @param n The size of the source range.
+ * @param dest The begin iterator of the destination range.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class ExecutionPolicy, class InputIter, class Size,
+          class ForwardIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, ForwardIter>
+uninitialized_copy_n(ExecutionPolicy &&, InputIter first, Size n,
+                     ForwardIter dest) {
+  if constexpr (use_parallel_v<ExecutionPolicy, InputIter, ForwardIter>) {
+    return tiny_stl::par_uninit_construct(
+        dest, n, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_copy(first + begin, first + end,
+                                       dest + begin);
+        });
+  } else {
+    return tiny_stl::uninitialized_copy_n(first, n, dest);
+  }
+}
+
+/**
+ * @brief Fill a range of objects with a value with an execution policy.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam ForwardIter The type of the iterators.
+ * @tparam T The type of the value.
+ * @param first The begin iterator of the range.
+ * @param last The end iterator of the range.
+ * @param value The value to be filled.
+ */
+template <class ExecutionPolicy, class ForwardIter, class T>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>>
+uninitialized_fill(ExecutionPolicy &&, ForwardIter first, ForwardIter last,
+                   const T &value) {
+  if constexpr (use_parallel_v<ExecutionPolicy, ForwardIter>) {
+    tiny_stl::par_uninit_construct(
+        first, last - first, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_fill(first + begin, first + end, value);
+        });
+  } else {
+    tiny_stl::uninitialized_fill(first, last, value);
+  }
+}
+
+/**
+ * @brief Fill a range of objects with a value with an execution policy.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam ForwardIter The type of the iterators.
+ * @tparam Size The type of the size.
+ * @tparam T The type of the value.
+ * @param first The begin iterator of the range.
+ * @param n The size of the range.
+ * @param value The value to be filled.
+ * @return ForwardIter The end iterator of the range.
+ */
+template <class ExecutionPolicy, class ForwardIter, class Size, class T>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, ForwardIter>
+uninitialized_fill_n(ExecutionPolicy &&, ForwardIter first, Size n,
+                     const T &value) {
+  if constexpr (use_parallel_v<ExecutionPolicy, ForwardIter>) {
+    return tiny_stl::par_uninit_construct(
+        first, n, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_fill_n(first + begin, end - begin, value);
+        });
+  } else {
+    return tiny_stl::uninitialized_fill_n(first, n, value);
+  }
+}
+
+/**
+ * @brief Move a range of objects to a raw memory with an execution policy.
+ * @note If the construction fails, the objects of the source range may have
+ * been moved from.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam InputIter The type of the iterators.
+ * @tparam ForwardIter The type of the destination iterators.
+ * @param first The begin iterator of the source range.
+ * @param last The end iterator of the source range.
+ * @param dest The begin iterator of the destination range.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class ExecutionPolicy, class InputIter, class ForwardIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, ForwardIter>
+uninitialized_move(ExecutionPolicy &&, InputIter first, InputIter last,
+                   ForwardIter dest) {
+  if constexpr (use_parallel_v<ExecutionPolicy, InputIter, ForwardIter>) {
+    return tiny_stl::par_uninit_construct(
+        dest, last - first, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_move(first + begin, first + end,
+                                       dest + begin);
+        });
+  } else {
+    return tiny_stl::uninitialized_move(first, last, dest);
+  }
+}
+
+/**
+ * @brief Move a range of objects to a raw memory with an execution policy.
+ * @note If the construction fails, the objects of the source range may have
+ * been moved from.
+ *
+ * @tparam ExecutionPolicy The type of the execution policy.
+ * @tparam InputIter The type of the iterators.
+ * @tparam Size The type of the size.
+ * @tparam ForwardIter The type of the destination iterators.
+ * @param first The begin iterator of the source range.
+ * @param n The size of the source range.
+ * @param dest The begin iterator of the destination range.
+ * @return ForwardIter The end iterator of the destination range.
+ */
+template <class ExecutionPolicy, class InputIter, class Size,
+          class ForwardIter>
+std::enable_if_t<tiny_stl::is_execution_policy_v<ExecutionPolicy>, ForwardIter>
+uninitialized_move_n(ExecutionPolicy &&, InputIter first, Size n,
+                     ForwardIter dest) {
+  if constexpr (use_parallel_v<ExecutionPolicy, InputIter, ForwardIter>) {
+    return tiny_stl::par_uninit_construct(
+        dest, n, [&](size_t begin, size_t end) {
+          tiny_stl::uninitialized_move(first + begin, first + end,
+                                       dest + begin);
+        });
+  } else {
+    return tiny_stl::uninitialized_move_n(first, n, dest);
+  }
 }
 
 } // namespace tiny_stl
@@ -50,6 +50,8 @@ private:
   iterator _begin;
   iterator _end;
   iterator _cap;
+  // Whether the storage came from `allocate_zeroed`.
+  bool _zeroed = false;
 
 public:
   vector() noexcept { try_init(); }
@@ -69,10 +71,12 @@ public:
   vector(const vector &other) { range_init(other._begin, other._end); }
 
   vector(const vector &&other) noexcept
-      : _begin(other._begin), _end(other._end), _cap(other._cap) {
+      : _begin(other._begin), _end(other._end), _cap(other._cap),
+        _zeroed(other._zeroed) {
     other._begin = nullptr;
     other._end = nullptr;
     other._cap = nullptr;
+    other._zeroed = false;
   }
 
   vector(std::initializer_list<value_type> ilist) {
@@ -89,7 +93,7 @@ public:
   }
 
   ~vector() {
-    destroy_and_recover(_begin, _end, _cap - _begin);
+    destroy_and_recover();
     _begin = _end = _cap = nullptr;
   }
 
@@ -220,6 +224,8 @@ private:
   template <class Iter> void range_init(Iter first, Iter last);
 
   void destroy_and_recover(iterator first, iterator last, size_type n);
+  void destroy_and_recover();
+  void recover_space();
 
   size_type get_new_cap(size_type add_size);
 
@@ -262,13 +268,15 @@ template <class T> vector<T> &vector<T>::operator=(const vector &other) {
 }
 
 template <class T> vector<T> &vector<T>::operator=(vector &&other) noexcept {
-  destroy_and_recover(_begin, _end, _cap - _begin);
+  destroy_and_recover();
   _begin = other._begin;
   _end = other._end;
   _cap = other._cap;
+  _zeroed = other._zeroed;
   other._begin = nullptr;
   other._end = nullptr;
   other._cap = nullptr;
+  other._zeroed = false;
 }
 
 template <class T> void vector<T>::reserve(size_type n) {
@@ -278,8 +286,8 @@ template <class T> void vector<T>::reserve(size_type n) {
         "n can not be greater than max_size() in vector<T>::reserve(n)");
     const auto old_size = size();
     auto tmp = data_allocator::allocate(n);
-    tiny_stl::uninitialized_move(_begin, _end, tmp);
-    data_allocator::deallocate(_begin, _cap - _begin);
+    tiny_stl::uninitialized_relocate_move(_begin, _end, tmp);
+    recover_space();
     _begin = tmp;
     _end = tmp + old_size;
     _cap = _begin + n;
@@ -320,8 +328,8 @@ template <class T>
 template <class... Args>
 void vector<T>::emplace_back(Args &&...args) {
   if (_end < _cap) {
-    data_allocator::construct(
-        tiny_stl::address_of(*_end, tiny_stl::forward<Args>(args)...));
+    data_allocator::construct(tiny_stl::address_of(*_end),
+                              tiny_stl::forward<Args>(args)...);
     ++_end;
   } else {
     reallocate_emplace(_end, tiny_stl::forward<Args>(args)...);
@@ -329,7 +337,7 @@ void vector<T>::emplace_back(Args &&...args) {
 }
 
 template <class T> void vector<T>::push_back(const value_type &value) {
-  if (_end == _cap) {
+  if (_end != _cap) {
     data_allocator::construct(tiny_stl::address_of(*_end), value);
     ++_end;
   } else {
@@ -381,8 +389,7 @@ typename vector<T>::iterator vector<T>::erase(const_iterator first,
                                               const_iterator last) {
   TINY_STL__DEBUG(first >= begin() && last <= end() && !(last < first));
   const auto n = first - begin();
-  iterator erase_begin = _begin;
-  tiny_stl::advance(erase_begin, tiny_stl::distance(_begin, first));
+  iterator erase_begin = _begin + n;
   data_allocator::destroy(
       tiny_stl::move(erase_begin + (last - first), _end, erase_begin), _end);
   _end = _end - (last - first);
@@ -403,6 +410,7 @@ template <class T> void vector<T>::swap(vector &other) noexcept {
     tiny_stl::swap(_begin, other._begin);
     tiny_stl::swap(_end, other._end);
     tiny_stl::swap(_cap, other._cap);
+    tiny_stl::swap(_zeroed, other._zeroed);
   }
 }
 
@@ -434,6 +442,14 @@ template <class T> void vector<T>::init_space(size_type size, size_type cap) {
 template <class T>
 void vector<T>::fill_init(size_type n, const value_type &value) {
   const size_type init_size = tiny_stl::max(static_cast<size_type>(16), n);
+  if (tiny_stl::all_zero_bytes(value)) {
+    // zeroed memory is already filled, without writing a byte of it
+    _begin = data_allocator::allocate_zeroed(init_size);
+    _end = _begin + n;
+    _cap = _begin + init_size;
+    _zeroed = true;
+    return;
+  }
   init_space(n, init_size);
   tiny_stl::uninitialized_fill_n(_begin, n, value);
 }
@@ -454,6 +470,20 @@ void vector<T>::destroy_and_recover(iterator first, iterator last,
   data_allocator::deallocate(first, n);
 }
 
+template <class T> void vector<T>::destroy_and_recover() {
+  data_allocator::destroy(_begin, _end);
+  recover_space();
+}
+
+template <class T> void vector<T>::recover_space() {
+  if (_zeroed) {
+    data_allocator::deallocate_zeroed(_begin, _cap - _begin);
+    _zeroed = false;
+  } else {
+    data_allocator::deallocate(_begin, _cap - _begin);
+  }
+}
+
 template <class T>
 typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
   const auto old_size = capacity();
@@ -477,7 +507,7 @@ void vector<T>::fill_assign(size_type n, const value_type &value) {
     swap(tmp);
   } else if (n > size()) {
     tiny_stl::fill(begin(), end(), value);
-    _end = tiny_stl::uninitialized_fill(_end, n - size(), value);
+    _end = tiny_stl::uninitialized_fill_n(_end, n - size(), value);
   } else {
     erase(tiny_stl::fill_n(_begin, n, value), _end);
   }
@@ -526,15 +556,16 @@ void vector<T>::reallocate_emplace(iterator pos, Args &&...args) {
   auto new_begin = data_allocator::allocate(new_size);
   auto new_end = new_begin;
   try {
-    new_end = tiny_stl::uninitialized_move(_begin, pos, new_begin);
+    new_end = tiny_stl::uninitialized_relocate_move(_begin, pos, new_begin);
     data_allocator::construct(tiny_stl::address_of(*new_end),
                               tiny_stl::forward<Args>(args)...);
     ++new_end;
-    new_end = tiny_stl::uninitialized_move(pos, _end, new_end);
+    new_end = tiny_stl::uninitialized_relocate_move(pos, _end, new_end);
   } catch (...) {
-    data_allocator::destroy(new_begin, new_size);
+    destroy_and_recover(new_begin, new_end, new_size);
+    throw;
   }
-  destroy_and_recover(_begin, _end, _cap - _begin);
+  destroy_and_recover();
   _begin = new_begin;
   _end = new_end;
   _cap = new_begin + new_size;
@@ -547,15 +578,15 @@ void vector<T>::reallocate_insert(iterator pos, const value_type &value) {
   auto new_end = new_begin;
   const value_type &value_copy = value;
   try {
-    new_end = tiny_stl::uninitialized_move(_begin, pos, new_begin);
+    new_end = tiny_stl::uninitialized_relocate_move(_begin, pos, new_begin);
     data_allocator::construct(tiny_stl::address_of(*new_end), value_copy);
     ++new_end;
-    new_end = tiny_stl::uninitialized_move(pos, _end, new_end);
+    new_end = tiny_stl::uninitialized_relocate_move(pos, _end, new_end);
   } catch (...) {
     data_allocator::deallocate(new_begin, new_size);
     throw;
   }
-  destroy_and_recover(_begin, _end, _cap - _begin);
+  destroy_and_recover();
   _begin = new_begin;
   _end = new_end;
   _cap = new_begin + new_size;
@@ -587,14 +618,14 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n,
     auto new_begin = data_allocator::allocate(new_size);
     auto new_end = new_begin;
     try {
-      new_end = tiny_stl::uninitialized_move(_begin, pos, new_begin);
+      new_end = tiny_stl::uninitialized_relocate_move(_begin, pos, new_begin);
       new_end = tiny_stl::uninitialized_fill_n(new_end, n, value);
-      new_end = tiny_stl::uninitialized_move(pos, _end, new_end);
+      new_end = tiny_stl::uninitialized_relocate_move(pos, _end, new_end);
     } catch (...) {
       destroy_and_recover(new_begin, new_end, new_size);
       throw;
     }
-    data_allocator::deallocate(_begin, _cap - _begin);
+    recover_space();
     _begin = new_begin;
     _end = new_end;
     _cap = _begin + new_size;
@@ -628,14 +659,14 @@ void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
     auto new_begin = data_allocator::allocate(new_size);
     auto new_end = new_begin;
     try {
-      new_end = tiny_stl::uninitialized_move(_begin, pos, new_begin);
+      new_end = tiny_stl::uninitialized_relocate_move(_begin, pos, new_begin);
       new_end = tiny_stl::uninitialized_copy(first, last, new_end);
-      new_end = tiny_stl::uninitialized_move(pos, _end, new_end);
+      new_end = tiny_stl::uninitialized_relocate_move(pos, _end, new_end);
     } catch (...) {
       destroy_and_recover(new_begin, new_end, new_size);
       throw;
     }
-    data_allocator::deallocate(_begin, _cap - _begin);
+    recover_space();
     _begin = new_begin;
     _end = new_end;
     _cap = _begin + new_size;
@@ -650,7 +681,7 @@ template <class T> void vector<T>::reinsert(size_type size) {
     data_allocator::deallocate(new_begin, size);
     throw;
   }
-  data_allocator::deallocate(_begin, _cap - _begin);
+  recover_space();
   _begin = new_begin;
   _end = _begin + size;
   _cap = _begin + size;
@@ -7,6 +7,22 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 using vector = TestAlgo::vector;
 using list = TestAlgo::list;
 
@@ -633,4 +649,1122 @@ TEST_F(TestAlgo, Merge_Compare) {
   EXPECT_EQ(v3, vector({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
 }
 
+template <class T> void check_simd_find_count() {
+  for (size_t n = 0; n < 150; n += 7) {
+    // 1 to 50 over and over, filled without indexing, which some GCC
+    // versions flag with -Wstringop-overflow for the char types at -O2.
+    std::vector<T> data(n);
+    int next = 0;
+    std::generate(data.begin(), data.end(), [&next] {
+      next = next % 50 + 1;
+      return static_cast<T>(next);
+    });
+    const T *first = data.data();
+    const T *last = first + n;
+    for (T value : {T(0), T(1), T(17), T(49)}) {
+      EXPECT_EQ(std::find(first, last, value),
+                tiny_stl::find(first, last, value));
+      EXPECT_EQ(static_cast<size_t>(std::count(first, last, value)),
+                tiny_stl::count(first, last, value));
+    }
+    if (n > 0) {
+      data.back() = T(0);
+      EXPECT_EQ(last - 1, tiny_stl::find(first, last, T(0)));
+      EXPECT_EQ(1u, tiny_stl::count(first, last, T(0)));
+    }
+  }
+}
+
+TEST_F(TestAlgo, Find_Simd) {
+  check_simd_find_count<std::int8_t>();
+  check_simd_find_count<unsigned char>();
+  check_simd_find_count<std::uint16_t>();
+  check_simd_find_count<std::int32_t>();
+  check_simd_find_count<std::int64_t>();
+  check_simd_find_count<float>();
+  check_simd_find_count<double>();
+
+  // Equality of floating-point values, not of their bits.
+  std::vector<double> doubles(40, 1.0);
+  doubles[20] = -0.0;
+  doubles[30] = std::nan("");
+  EXPECT_EQ(20, tiny_stl::find(doubles.data(), doubles.data() + 40, 0.0) -
+                    doubles.data());
+  EXPECT_EQ(1u, tiny_stl::count(doubles.data(), doubles.data() + 40, 0));
+  EXPECT_EQ(0u, tiny_stl::count(doubles.data(), doubles.data() + 40,
+                                std::nan("")));
+
+  // Values which do not convert to the element type are compared as before.
+  std::vector<unsigned> words(40, 7u);
+  words[33] = 0xFFFFFFFFu;
+  EXPECT_EQ(33, tiny_stl::find(words.data(), words.data() + 40, -1) -
+                    words.data());
+  EXPECT_EQ(0u, tiny_stl::count(words.data(), words.data() + 40, 1ull << 40));
+  EXPECT_EQ(39u, tiny_stl::count(words.data(), words.data() + 40, 7ll));
+}
+
+TEST_F(TestAlgo, Remove_Simd) {
+  std::vector<std::int32_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i % 97 == 0 || i % 13 == 5 ? -1 : static_cast<int>(i);
+  auto expected = data;
+  expected.erase(std::remove(expected.begin(), expected.end(), -1),
+                 expected.end());
+  auto end = tiny_stl::remove(data.data(), data.data() + data.size(), -1);
+  EXPECT_EQ(expected, std::vector<std::int32_t>(data.data(), end));
+
+  std::vector<std::int16_t> shorts(300, 3);
+  for (size_t i = 100; i < 104; ++i)
+    shorts[i] = 9;
+  EXPECT_EQ(shorts.data() + 100,
+            tiny_stl::search_n(shorts.data(), shorts.data() + 300, 4, 9));
+  EXPECT_EQ(shorts.data() + 300,
+            tiny_stl::search_n(shorts.data(), shorts.data() + 300, 5, 9));
+}
+
+TEST_F(TestAlgo, Sort) {
+  std::mt19937_64 gen(1);
+  vector data(10000);
+  for (auto &value : data) {
+    value = static_cast<int>(gen() % 1000);
+  }
+  auto expected = data;
+  std::sort(expected.begin(), expected.end());
+  tiny_stl::sort(data.data(), data.data() + data.size());
+  EXPECT_EQ(expected, data);
+  tiny_stl::sort(data.data(), data.data() + data.size(), std::greater<int>());
+  std::reverse(expected.begin(), expected.end());
+  EXPECT_EQ(expected, data);
+}
+
+TEST_F(TestAlgo, Sort_Patterns) {
+  const int n = 100000;
+  std::mt19937_64 gen(3);
+  std::vector<vector> inputs;
+  vector data(n);
+  for (int i = 0; i < n; ++i)
+    data[i] = i;
+  inputs.push_back(data); // sorted
+  std::reverse(data.begin(), data.end());
+  inputs.push_back(data); // reverse sorted
+  for (int i = 0; i < n; ++i)
+    data[i] = i < n / 2 ? i : n - i;
+  inputs.push_back(data); // organ pipe
+  for (int i = 0; i < n; ++i)
+    data[i] = i % 1000;
+  inputs.push_back(data); // sawtooth
+  for (int i = 0; i < n; ++i)
+    data[i] = static_cast<int>(gen() % 4);
+  inputs.push_back(data); // few unique
+  for (int i = 0; i < n; ++i)
+    data[i] = i;
+  data[n / 3] = -1;
+  inputs.push_back(data); // nearly sorted
+
+  for (const auto &input : inputs) {
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    auto branchless = input;
+    tiny_stl::sort(branchless.data(), branchless.data() + n);
+    EXPECT_EQ(expected, branchless);
+    auto branchy = input;
+    tiny_stl::sort(branchy.data(), branchy.data() + n,
+                   [](int a, int b) { return a < b; });
+    EXPECT_EQ(expected, branchy);
+  }
+
+  // Sorted, reverse sorted and all-equal inputs take linear time.
+  for (int pattern = 0; pattern < 3; ++pattern) {
+    for (int i = 0; i < n; ++i)
+      data[i] = pattern == 0 ? i : pattern == 1 ? n - i : 7;
+    size_t comparisons = 0;
+    tiny_stl::sort(data.data(), data.data() + n, [&](int a, int b) {
+      ++comparisons;
+      return a < b;
+    });
+    EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+    EXPECT_LT(comparisons, 4u * n);
+  }
+
+  std::vector<std::string> strs(20000);
+  for (auto &str : strs)
+    str = std::to_string(gen() % 3000);
+  auto expected = strs;
+  std::sort(expected.begin(), expected.end());
+  tiny_stl::sort(strs.data(), strs.data() + strs.size());
+  EXPECT_EQ(expected, strs);
+}
+
+TEST_F(TestAlgo, Sort_Small) {
+  // Every network sorts all its inputs of zeros and ones.
+  for (size_t n = 2; n <= 16; ++n) {
+    for (unsigned bits = 0; bits < (1u << n); ++bits) {
+      int data[16];
+      for (size_t i = 0; i < n; ++i)
+        data[i] = static_cast<int>(bits >> i & 1);
+      tiny_stl::sort(data, data + n);
+      EXPECT_TRUE(std::is_sorted(data, data + n));
+      EXPECT_EQ(__builtin_popcount(bits), std::count(data, data + n, 1));
+    }
+  }
+
+  std::mt19937_64 gen(4);
+  for (int round = 0; round < 2000; ++round) {
+    const size_t n = gen() % 80;
+    vector ints(n);
+    std::vector<unsigned> uints(n);
+    std::vector<double> doubles(n);
+    for (size_t i = 0; i < n; ++i) {
+      ints[i] = static_cast<int>(gen() % 41) - 20;
+      uints[i] = static_cast<unsigned>(gen());
+      // Zeros of both signs, which are equal but must both be kept.
+      doubles[i] = (gen() % 5) * (gen() % 2 ? -0.5 : 0.5);
+    }
+    auto expected_ints = ints;
+    std::sort(expected_ints.begin(), expected_ints.end());
+    auto stable_ints = ints;
+    tiny_stl::sort(ints.data(), ints.data() + n);
+    EXPECT_EQ(expected_ints, ints);
+    tiny_stl::stable_sort(stable_ints.data(), stable_ints.data() + n);
+    EXPECT_EQ(expected_ints, stable_ints);
+
+    auto expected_uints = uints;
+    std::sort(expected_uints.begin(), expected_uints.end());
+    tiny_stl::sort(uints.data(), uints.data() + n);
+    EXPECT_EQ(expected_uints, uints);
+
+    const auto negative_zero = [](double x) {
+      return x == 0 && std::signbit(x);
+    };
+    const auto zeros =
+        std::count_if(doubles.begin(), doubles.end(), negative_zero);
+    tiny_stl::sort(doubles.data(), doubles.data() + n, std::greater<>());
+    EXPECT_TRUE(
+        std::is_sorted(doubles.begin(), doubles.end(), std::greater<>()));
+    EXPECT_EQ(zeros,
+              std::count_if(doubles.begin(), doubles.end(), negative_zero));
+  }
+}
+
+TEST_F(TestAlgo, StableSort) {
+  std::mt19937_64 gen(5);
+  using item = std::pair<int, int>;
+  const auto by_key = [](const item &a, const item &b) {
+    return a.first < b.first;
+  };
+  for (int n : {0, 1, 31, 1000, 100000}) {
+    // Random keys with many duplicates, presorted batches and descending
+    // runs, the second member records the original order.
+    for (int pattern = 0; pattern < 3; ++pattern) {
+      std::vector<item> data(n);
+      for (int i = 0; i < n; ++i) {
+        int key = static_cast<int>(gen() % 100);
+        if (pattern == 1)
+          key = i % 5000;
+        else if (pattern == 2)
+          key = (n - i) / 3 + static_cast<int>(i / 777) * 1000;
+        data[i] = {key, i};
+      }
+      auto expected = data;
+      std::stable_sort(expected.begin(), expected.end(), by_key);
+      tiny_stl::stable_sort(data.data(), data.data() + n, by_key);
+      EXPECT_EQ(expected, data);
+    }
+  }
+
+  // The merges with a short buffer and without one.
+  for (std::ptrdiff_t buffer_size : {0, 10}) {
+    std::vector<item> data(3000);
+    for (int i = 0; i < 3000; ++i)
+      data[i] = {static_cast<int>(gen() % 50), i};
+    std::stable_sort(data.begin(), data.begin() + 1200, by_key);
+    std::stable_sort(data.begin() + 1200, data.end(), by_key);
+    auto expected = data;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    item buffer[10];
+    tiny_stl::stable_sort_merge(data.data(), data.data() + 1200,
+                                data.data() + 3000, buffer, buffer_size,
+                                by_key);
+    EXPECT_EQ(expected, data);
+  }
+
+  std::vector<std::string> strs(30000);
+  for (auto &str : strs)
+    str = std::to_string(gen() % 10000);
+  auto expected = strs;
+  std::stable_sort(expected.begin(), expected.end());
+  tiny_stl::stable_sort(strs.data(), strs.data() + strs.size());
+  EXPECT_EQ(expected, strs);
+}
+
+TEST_F(TestAlgo, StableSort_Runs) {
+  // Concatenated sorted batches take about one comparison per element and
+  // one merge pass per level of batches.
+  const int n = 1 << 17;
+  vector data(n);
+  for (int i = 0; i < n; ++i)
+    data[i] = (i * 37) % 5000 + (i / 8192) * 3;
+  for (int i = 0; i < n; i += 8192)
+    std::sort(data.begin() + i, data.begin() + i + 8192);
+  size_t comparisons = 0;
+  tiny_stl::stable_sort(data.data(), data.data() + n, [&](int a, int b) {
+    ++comparisons;
+    return a < b;
+  });
+  EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+  EXPECT_LT(comparisons, 6u * n);
+
+  for (int i = 0; i < n; ++i)
+    data[i] = n - i;
+  comparisons = 0;
+  tiny_stl::stable_sort(data.data(), data.data() + n, [&](int a, int b) {
+    ++comparisons;
+    return a < b;
+  });
+  EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+  EXPECT_LT(comparisons, 2u * n);
+}
+
+TEST_F(TestAlgo, Sort_Parallel) {
+  tiny_stl::set_default_thread_count(8);
+  std::mt19937_64 gen(2);
+  const size_t n = 1 << 18;
+  // Unique keys, heavy duplicates and all-equal keys.
+  for (std::uint64_t mod : {0ull, 100ull, 1ull}) {
+    std::vector<std::uint64_t> keys(n);
+    for (auto &key : keys) {
+      key = mod == 0 ? gen() : gen() % mod;
+    }
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+    tiny_stl::sort(tiny_stl::par, keys.data(), keys.data() + n);
+    EXPECT_EQ(expected, keys);
+    tiny_stl::sort(tiny_stl::par, keys.data(), keys.data() + n,
+                   std::greater<std::uint64_t>());
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(expected, keys);
+  }
+  std::vector<std::string> strs(1 << 16);
+  for (auto &str : strs) {
+    str = std::to_string(gen() % 50000);
+  }
+  auto expected = strs;
+  std::sort(expected.begin(), expected.end());
+  tiny_stl::sort(tiny_stl::par, strs.data(), strs.data() + strs.size());
+  EXPECT_EQ(expected, strs);
+  tiny_stl::sort(tiny_stl::seq, strs.data(), strs.data() + strs.size());
+  EXPECT_EQ(expected, strs);
+
+  // A move-only type is accepted, as by the sequential sort.
+  std::vector<std::unique_ptr<int>> ptrs(1 << 16);
+  for (auto &ptr : ptrs) {
+    ptr = std::make_unique<int>(static_cast<int>(gen() % 1000));
+  }
+  tiny_stl::sort(tiny_stl::par, ptrs.data(), ptrs.data() + ptrs.size(),
+                 [](const auto &a, const auto &b) { return *a < *b; });
+  EXPECT_TRUE(std::is_sorted(
+      ptrs.begin(), ptrs.end(),
+      [](const auto &a, const auto &b) { return *a < *b; }));
+  tiny_stl::set_default_thread_count(
+      std::max(2u, std::thread::hardware_concurrency()));
+}
+
+TEST_F(TestAlgo, RadixSort) {
+  std::mt19937_64 gen(7);
+  for (size_t n : {0u, 1u, 63u, 1000u, 70000u}) {
+    std::vector<std::uint64_t> u64(n);
+    std::vector<std::int32_t> i32(n);
+    std::vector<double> f64(n);
+    std::vector<float> f32(n);
+    for (size_t i = 0; i < n; ++i) {
+      u64[i] = i % 3 == 0 ? gen() : gen() % 1000;
+      i32[i] = static_cast<std::int32_t>(gen());
+      f64[i] = (static_cast<double>(gen() % 20001) - 10000.0) / 7.0;
+      f32[i] = static_cast<float>(f64[i] * 1e-3);
+    }
+    auto check = [](auto v, bool inplace) {
+      auto expected = v;
+      std::sort(expected.begin(), expected.end());
+      if (inplace) {
+        tiny_stl::inplace_radix_sort(v.data(), v.data() + v.size());
+      } else {
+        tiny_stl::radix_sort(v.data(), v.data() + v.size());
+      }
+      EXPECT_EQ(expected, v);
+    };
+    for (bool inplace : {false, true}) {
+      check(u64, inplace);
+      check(i32, inplace);
+      check(f64, inplace);
+      check(f32, inplace);
+    }
+  }
+
+  std::vector<double> specials = {3.5, -0.0, 0.0, -1e300, 1e-300, -2.5, 1e300};
+  auto expected = specials;
+  std::sort(expected.begin(), expected.end());
+  tiny_stl::radix_sort(specials.data(), specials.data() + specials.size());
+  EXPECT_EQ(expected, specials);
+  EXPECT_TRUE(std::signbit(specials[2]));
+  EXPECT_FALSE(std::signbit(specials[3]));
+
+  // A constant high part is skipped, only the low byte differs.
+  std::vector<std::uint64_t> same_high(5000);
+  for (size_t i = 0; i < same_high.size(); ++i) {
+    same_high[i] = 0xABCD000000000000ull | (gen() & 0xFF);
+  }
+  auto sorted = same_high;
+  std::sort(sorted.begin(), sorted.end());
+  tiny_stl::inplace_radix_sort(same_high.data(),
+                               same_high.data() + same_high.size());
+  EXPECT_EQ(sorted, same_high);
+}
+
+TEST_F(TestAlgo, RadixSort_KeyOf) {
+  struct record {
+    std::int64_t id;
+    std::string name;
+  };
+  std::mt19937_64 gen(11);
+  std::vector<record> records(100000);
+  for (size_t i = 0; i < records.size(); ++i) {
+    records[i] = {static_cast<std::int64_t>(gen() % 5000) - 2500,
+                  std::to_string(i)};
+  }
+  auto expected = records;
+  std::stable_sort(
+      expected.begin(), expected.end(),
+      [](const record &a, const record &b) { return a.id < b.id; });
+  auto key_of = [](const record &r) { return r.id; };
+  auto stable = records;
+  tiny_stl::radix_sort(stable.data(), stable.data() + stable.size(), key_of);
+  auto inplace = records;
+  tiny_stl::inplace_radix_sort(inplace.data(), inplace.data() + inplace.size(),
+                               key_of);
+  for (size_t i = 0; i < records.size(); ++i) {
+    // The LSD sort is stable, the in-place sort only orders the keys.
+    EXPECT_EQ(expected[i].id, stable[i].id);
+    EXPECT_EQ(expected[i].name, stable[i].name);
+    EXPECT_EQ(expected[i].id, inplace[i].id);
+  }
+
+  // A throwing `key_of` leaves nothing allocated, before or after the
+  // elements are constructed in the buffer.
+  const size_t n = records.size();
+  for (size_t limit : {n / 2, 2 * n + n / 2}) {
+    size_t calls = 0;
+    auto throwing_key_of = [&](const record &r) {
+      if (++calls > limit) {
+        throw std::runtime_error("key_of");
+      }
+      return r.id;
+    };
+    auto copy = records;
+    EXPECT_THROW(tiny_stl::radix_sort(copy.data(), copy.data() + n,
+                                      throwing_key_of),
+                 std::runtime_error);
+  }
+}
+
+TEST_F(TestAlgo, Bounds_Branchless) {
+  std::mt19937 gen(39);
+  for (size_t n : {0, 1, 2, 3, 7, 8, 100, 1000, 4097}) {
+    vector v(n);
+    for (auto &x : v) {
+      x = static_cast<int>(gen() % (n / 2 + 1));
+    }
+    std::sort(v.begin(), v.end());
+    auto descending = v;
+    std::reverse(descending.begin(), descending.end());
+    const int *first = v.data(), *last = v.data() + n;
+    const int *dfirst = descending.data(), *dlast = descending.data() + n;
+    for (int x = -1; x <= static_cast<int>(n / 2) + 1; ++x) {
+      EXPECT_EQ(std::lower_bound(first, last, x),
+                tiny_stl::lower_bound(first, last, x));
+      EXPECT_EQ(std::upper_bound(first, last, x),
+                tiny_stl::upper_bound(first, last, x));
+      auto range = tiny_stl::equal_range(first, last, x);
+      EXPECT_EQ(std::equal_range(first, last, x),
+                std::make_pair(range.first, range.second));
+      EXPECT_EQ(std::binary_search(first, last, x),
+                tiny_stl::binary_search(first, last, x));
+
+      std::greater<int> greater;
+      EXPECT_EQ(std::lower_bound(dfirst, dlast, x, greater),
+                tiny_stl::lower_bound(dfirst, dlast, x, greater));
+      EXPECT_EQ(std::upper_bound(dfirst, dlast, x, greater),
+                tiny_stl::upper_bound(dfirst, dlast, x, greater));
+      range = tiny_stl::equal_range(dfirst, dlast, x, greater);
+      EXPECT_EQ(std::equal_range(dfirst, dlast, x, greater),
+                std::make_pair(range.first, range.second));
+      EXPECT_EQ(std::binary_search(dfirst, dlast, x, greater),
+                tiny_stl::binary_search(dfirst, dlast, x, greater));
+    }
+  }
+
+  // Ranges larger than `kBranchlessPrefetchBytes` take the prefetching loop
+  // until the range left is cached.
+  const size_t large = 4 * tiny_stl::kBranchlessPrefetchBytes / sizeof(int);
+  vector big(large);
+  for (size_t i = 0; i < large; ++i) {
+    big[i] = static_cast<int>(i / 3);
+  }
+  const int *bfirst = big.data(), *blast = big.data() + large;
+  for (int i = 0; i < 2000; ++i) {
+    const int x = static_cast<int>(gen() % (large / 3 + 2)) - 1;
+    EXPECT_EQ(std::lower_bound(bfirst, blast, x),
+              tiny_stl::lower_bound(bfirst, blast, x));
+    EXPECT_EQ(std::upper_bound(bfirst, blast, x),
+              tiny_stl::upper_bound(bfirst, blast, x));
+  }
+
+  // The searched value may have a different type than the elements.
+  std::vector<double> d = {0.5, 1.5, 1.5, 2.5};
+  EXPECT_EQ(tiny_stl::lower_bound(d.data(), d.data() + d.size(), 1),
+            d.data() + 1);
+  EXPECT_EQ(tiny_stl::upper_bound(d.data(), d.data() + d.size(), 2),
+            d.data() + 3);
+}
+
+TEST_F(TestAlgo, LowerBoundBatch) {
+  std::mt19937 gen(41);
+  for (size_t n : {0, 1, 5, 100, 5000, 100000}) {
+    vector v(n);
+    for (auto &x : v) {
+      x = static_cast<int>(gen() % (2 * n + 1));
+    }
+    std::sort(v.begin(), v.end());
+    const int *first = v.data(), *last = v.data() + n;
+    for (size_t m : {0, 1, 15, 16, 17, 1000}) {
+      vector keys(m);
+      for (auto &key : keys) {
+        key = static_cast<int>(gen() % (2 * n + 3)) - 1;
+      }
+      auto sorted_keys = keys;
+      std::sort(sorted_keys.begin(), sorted_keys.end());
+      for (const auto *batch : {&keys, &sorted_keys}) {
+        std::vector<const int *> result(m);
+        auto end = tiny_stl::lower_bound_batch(first, last, batch->begin(),
+                                               batch->end(), result.begin());
+        EXPECT_EQ(result.end(), end);
+        for (size_t i = 0; i < m; ++i) {
+          EXPECT_EQ(std::lower_bound(first, last, (*batch)[i]), result[i]);
+        }
+      }
+
+      vector descending = v;
+      std::reverse(descending.begin(), descending.end());
+      const int *dfirst = descending.data(), *dlast = dfirst + n;
+      std::vector<const int *> result(m);
+      tiny_stl::lower_bound_batch(dfirst, dlast, keys.begin(), keys.end(),
+                                  result.begin(), std::greater<int>());
+      for (size_t i = 0; i < m; ++i) {
+        EXPECT_EQ(std::lower_bound(dfirst, dlast, keys[i], std::greater<int>()),
+                  result[i]);
+      }
+    }
+  }
+
+  // A comparator taking only an element and a key, as `lower_bound` allows.
+  struct item {
+    int key;
+  };
+  struct item_before_key {
+    bool operator()(const item &x, int key) const { return x.key < key; }
+  };
+  std::vector<item> items = {{1}, {3}, {3}, {8}};
+  vector keys = {0, 3, 4, 9, 2};
+  std::vector<const item *> result(keys.size());
+  tiny_stl::lower_bound_batch(items.data(), items.data() + items.size(),
+                              keys.begin(), keys.end(), result.begin(),
+                              item_before_key());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(std::lower_bound(items.data(), items.data() + items.size(),
+                               keys[i], item_before_key()),
+              result[i]);
+  }
+}
+
+TEST_F(TestAlgo, NthElement_Patterns) {
+  std::mt19937 gen(42);
+  auto check = [&](vector data, size_t nth, auto comp) {
+    auto sorted = data;
+    std::sort(sorted.begin(), sorted.end(), comp);
+    tiny_stl::nth_element(data.data(), data.data() + nth,
+                          data.data() + data.size(), comp);
+    ASSERT_EQ(sorted[nth], data[nth]);
+    for (size_t i = 0; i < nth; ++i) {
+      ASSERT_FALSE(comp(data[nth], data[i]));
+    }
+    for (size_t i = nth + 1; i < data.size(); ++i) {
+      ASSERT_FALSE(comp(data[i], data[nth]));
+    }
+  };
+  for (size_t n : {1, 2, 5, 23, 24, 100, 129, 601, 5000, 100000}) {
+    std::vector<vector> patterns(6, vector(n));
+    for (size_t i = 0; i < n; ++i) {
+      patterns[0][i] = static_cast<int>(gen());
+      patterns[1][i] = static_cast<int>(i);
+      patterns[2][i] = static_cast<int>(n - i);
+      patterns[3][i] = 7;
+      patterns[4][i] = static_cast<int>(gen() % 4);
+      patterns[5][i] = static_cast<int>(i < n / 2 ? i : n - i);
+    }
+    for (const auto &data : patterns) {
+      for (size_t nth : {size_t(0), size_t(1), n / 3, n / 2, n - 2, n - 1,
+                         static_cast<size_t>(gen() % n)}) {
+        if (nth >= n)
+          continue;
+        check(data, nth, std::less<int>());
+        check(data, nth, std::greater<int>());
+      }
+    }
+  }
+
+  std::vector<std::string> words = {"pear", "fig", "apple", "kiwi", "date",
+                                    "plum", "lime", "fig"};
+  auto sorted = words;
+  std::sort(sorted.begin(), sorted.end());
+  tiny_stl::nth_element(words.data(), words.data() + 3,
+                        words.data() + words.size());
+  EXPECT_EQ(sorted[3], words[3]);
+}
+
+TEST_F(TestAlgo, NthElement_Adversary) {
+  // McIlroy's adversary: the values are fixed only when compared, so that
+  // every pivot lands next to an end of the range. The selection falls back
+  // to medians of medians and stays linear.
+  const int n = 100000;
+  for (int nth : {n / 2, n / 3, n - 5}) {
+    const int gas = n;
+    vector value(n, gas);
+    vector index(n);
+    std::iota(index.begin(), index.end(), 0);
+    int solid = 0;
+    int candidate = -1;
+    size_t comparisons = 0;
+    auto less = [&](int x, int y) {
+      ++comparisons;
+      if (value[x] == gas && value[y] == gas) {
+        value[x == candidate ? x : y] = solid++;
+      }
+      if (value[x] == gas) {
+        candidate = x;
+      } else if (value[y] == gas) {
+        candidate = y;
+      }
+      return value[x] < value[y];
+    };
+    tiny_stl::nth_element(index.data(), index.data() + nth, index.data() + n,
+                          less);
+    const int pivot = value[index[nth]];
+    for (int i = 0; i < nth; ++i) {
+      ASSERT_FALSE(pivot < value[index[i]]);
+    }
+    for (int i = nth + 1; i < n; ++i) {
+      ASSERT_FALSE(value[index[i]] < pivot);
+    }
+    EXPECT_LT(comparisons, 16u * n);
+  }
+}
+
+TEST_F(TestAlgo, SelectK) {
+  std::mt19937 gen(42);
+  vector data(10000);
+  for (auto &x : data) {
+    x = static_cast<int>(gen() % 1000);
+  }
+  auto sorted = data;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t k : {0, 1, 10, 5000, 10000, 20000}) {
+    const size_t count = k < data.size() ? k : data.size();
+    vector copies(count);
+    auto copies_end = tiny_stl::select_k_copy(data.begin(), data.end(),
+                                              copies.data(), k);
+    EXPECT_EQ(copies.data() + count, copies_end);
+    EXPECT_TRUE(std::equal(copies.begin(), copies.end(), sorted.begin()));
+
+    auto selected = data;
+    auto end = tiny_stl::select_k(selected.data(),
+                                  selected.data() + selected.size(), k);
+    EXPECT_EQ(selected.data() + count, end);
+    EXPECT_TRUE(std::equal(selected.begin(), selected.begin() + count,
+                           sorted.begin()));
+    std::sort(selected.begin(), selected.end());
+    EXPECT_EQ(sorted, selected);
+  }
+
+  auto largest = data;
+  tiny_stl::select_k(largest.data(), largest.data() + largest.size(), 3,
+                     std::greater<int>());
+  EXPECT_EQ(sorted[sorted.size() - 1], largest[0]);
+  EXPECT_EQ(sorted[sorted.size() - 3], largest[2]);
+}
+
+TEST_F(TestAlgo, Shuffle) {
+  // Every permutation of three elements shows up about as often.
+  tiny_stl::xoshiro256starstar g(43);
+  std::map<std::vector<int>, size_t> counts;
+  for (int i = 0; i < 60000; ++i) {
+    std::vector<int> v = {0, 1, 2};
+    tiny_stl::shuffle(v.data(), v.data() + v.size(), g);
+    ++counts[v];
+  }
+  EXPECT_EQ(6u, counts.size());
+  for (const auto &count : counts) {
+    EXPECT_NEAR(10000.0, static_cast<double>(count.second), 600.0);
+  }
+
+  // The same seed gives the same permutation.
+  vector a(1000), b(1000);
+  std::iota(a.begin(), a.end(), 0);
+  std::iota(b.begin(), b.end(), 0);
+  tiny_stl::shuffle(a.data(), a.data() + a.size(), tiny_stl::pcg32(1));
+  tiny_stl::shuffle(b.data(), b.data() + b.size(), tiny_stl::pcg32(1));
+  EXPECT_EQ(a, b);
+
+  // `rand(n)` of the old interface returns an integer in [0, n).
+  vector c(1000);
+  std::iota(c.begin(), c.end(), 0);
+  std::mt19937 mt(43);
+  auto rand = [&](long n) {
+    return std::uniform_int_distribution<long>(0, n - 1)(mt);
+  };
+  tiny_stl::random_shuffle(c.data(), c.data() + c.size(), rand);
+  EXPECT_NE(a, c);
+  std::sort(c.begin(), c.end());
+  std::sort(a.begin(), a.end());
+  EXPECT_EQ(a, c);
+}
+
+TEST_F(TestAlgo, Shuffle_Parallel) {
+  tiny_stl::set_default_thread_count(3);
+  const size_t n = 1 << 20;
+  std::vector<std::uint32_t> v(n);
+  std::iota(v.begin(), v.end(), 0u);
+  tiny_stl::shuffle(tiny_stl::par, v.data(), v.data() + n,
+                    tiny_stl::xoshiro256starstar(44));
+  // Each quarter of the output takes about a quarter of each input quarter.
+  size_t counts[4][4] = {};
+  for (size_t i = 0; i < n; ++i) {
+    ++counts[i * 4 / n][v[i] * 4 / n];
+  }
+  for (auto &row : counts) {
+    for (size_t count : row) {
+      EXPECT_NEAR(n / 16.0, static_cast<double>(count), n / 160.0);
+    }
+  }
+  std::sort(v.begin(), v.end());
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(i, v[i]);
+  }
+
+  std::vector<std::string> words(100000);
+  for (size_t i = 0; i < words.size(); ++i) {
+    words[i] = std::to_string(i);
+  }
+  auto shuffled = words;
+  tiny_stl::xoshiro256starstar g(45);
+  tiny_stl::shuffle(tiny_stl::par, shuffled.data(),
+                    shuffled.data() + shuffled.size(), g);
+  EXPECT_NE(words, shuffled);
+  std::sort(words.begin(), words.end());
+  std::sort(shuffled.begin(), shuffled.end());
+  EXPECT_EQ(words, shuffled);
+  tiny_stl::set_default_thread_count(
+      std::max(2u, std::thread::hardware_concurrency()));
+}
+
+TEST_F(TestAlgo, Sample) {
+  tiny_stl::xoshiro256starstar g(44);
+  vector data(20);
+  std::iota(data.begin(), data.end(), 0);
+  const int *first = data.data(), *last = first + data.size();
+
+  // Forward ranges keep their order, every element is picked as often.
+  std::vector<size_t> counts(data.size());
+  for (int i = 0; i < 40000; ++i) {
+    int out[5];
+    EXPECT_EQ(out + 5, tiny_stl::sample(first, last, out, 5, g));
+    EXPECT_TRUE(std::is_sorted(out, out + 5));
+    for (int x : out) {
+      ++counts[x];
+    }
+  }
+  for (size_t count : counts) {
+    EXPECT_NEAR(10000.0, static_cast<double>(count), 450.0);
+  }
+
+  // The same for the reservoir of single pass ranges.
+  std::fill(counts.begin(), counts.end(), 0);
+  for (int i = 0; i < 40000; ++i) {
+    int out[5];
+    EXPECT_EQ(out + 5, tiny_stl::sample_dispatch(
+                           first, last, out, 5,
+                           tiny_stl::input_iterator_tag(), g));
+    std::sort(out, out + 5);
+    EXPECT_EQ(out + 5, std::unique(out, out + 5));
+    for (int x : out) {
+      ++counts[x];
+    }
+  }
+  for (size_t count : counts) {
+    EXPECT_NEAR(10000.0, static_cast<double>(count), 450.0);
+  }
+
+  // Short ranges are copied whole.
+  int out[30];
+  EXPECT_EQ(out + 20, tiny_stl::sample(first, last, out, 30, g));
+  EXPECT_TRUE(std::equal(first, last, out));
+  EXPECT_EQ(out + 20,
+            tiny_stl::sample_dispatch(first, last, out, 30,
+                                      tiny_stl::input_iterator_tag(), g));
+  EXPECT_EQ(out, tiny_stl::sample(first, last, out, 0, g));
+
+  // The reservoir skips ahead, drawing far fewer numbers than elements.
+  struct counting_engine {
+    tiny_stl::xoshiro256starstar engine;
+    size_t draws = 0;
+    using result_type = std::uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+    result_type operator()() {
+      ++draws;
+      return engine();
+    }
+  } counting{tiny_stl::xoshiro256starstar(45)};
+  vector big(1000000);
+  std::iota(big.begin(), big.end(), 0);
+  vector reservoir(100);
+  tiny_stl::sample_dispatch(big.data(), big.data() + big.size(),
+                            reservoir.data(), 100,
+                            tiny_stl::input_iterator_tag(), counting);
+  EXPECT_LT(counting.draws, 10000u);
+}
+
+TEST_F(TestAlgo, WeightedSample) {
+  tiny_stl::xoshiro256starstar g(46);
+  const vector weights = {1, 2, 0, 3, 4};
+  const int *first = weights.data(), *last = first + weights.size();
+  auto weight_of = [](int w) { return w; };
+
+  std::vector<size_t> counts(weights.size());
+  for (int i = 0; i < 100000; ++i) {
+    int out[1];
+    EXPECT_EQ(out + 1, tiny_stl::weighted_sample(first, last, out, 1,
+                                                 weight_of, g));
+    ++counts[std::find(first, last, out[0]) - first];
+  }
+  EXPECT_EQ(0u, counts[2]);
+  EXPECT_NEAR(10000.0, static_cast<double>(counts[0]), 600.0);
+  EXPECT_NEAR(20000.0, static_cast<double>(counts[1]), 800.0);
+  EXPECT_NEAR(30000.0, static_cast<double>(counts[3]), 900.0);
+  EXPECT_NEAR(40000.0, static_cast<double>(counts[4]), 1000.0);
+
+  // The heaviest elements are picked most often in larger samples too.
+  std::vector<double> many(1000);
+  for (size_t i = 0; i < many.size(); ++i) {
+    many[i] = i < 900 ? 1.0 : 100.0;
+  }
+  size_t heavy = 0;
+  for (int i = 0; i < 100; ++i) {
+    size_t out[50];
+    std::vector<size_t> indexes(many.size());
+    std::iota(indexes.begin(), indexes.end(), size_t(0));
+    auto end = tiny_stl::weighted_sample(
+        indexes.data(), indexes.data() + indexes.size(), out, 50,
+        [&](size_t j) { return many[j]; }, g);
+    EXPECT_EQ(out + 50, end);
+    std::sort(out, out + 50);
+    EXPECT_EQ(out + 50, std::unique(out, out + 50));
+    heavy += static_cast<size_t>(std::count_if(
+        out, out + 50, [](size_t j) { return j >= 900; }));
+  }
+  EXPECT_GT(heavy, 4000u);
+
+  // Only the elements of positive weight can be picked.
+  int out[5];
+  EXPECT_EQ(out + 4,
+            tiny_stl::weighted_sample(first, last, out, 5, weight_of, g));
+  std::sort(out, out + 4);
+  const vector expected = {1, 2, 3, 4};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out));
+}
+
+TEST_F(TestAlgo, SetOperations) {
+  // Multisets of every relative size, merged, galloped and compared by
+  // blocks, against the standard library.
+  std::mt19937 gen(46);
+  const size_t sizes[] = {0, 1, 3, 9, 40, 300, 5000};
+  for (size_t n1 : sizes) {
+    for (size_t n2 : sizes) {
+      for (std::uint32_t range : {8u, 1000u, 1000000u}) {
+        std::uniform_int_distribution<std::uint32_t> dist(0, range);
+        std::vector<std::uint32_t> a(n1), b(n2);
+        std::generate(a.begin(), a.end(), [&] { return dist(gen); });
+        std::generate(b.begin(), b.end(), [&] { return dist(gen); });
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        const auto *a1 = a.data(), *a2 = a.data() + a.size();
+        const auto *b1 = b.data(), *b2 = b.data() + b.size();
+        std::vector<std::uint32_t> expected, out(n1 + n2);
+
+        std::set_intersection(a1, a2, b1, b2, std::back_inserter(expected));
+        auto *last = tiny_stl::set_intersection(a1, a2, b1, b2, out.data());
+        EXPECT_EQ(expected, std::vector<std::uint32_t>(out.data(), last));
+        EXPECT_EQ(expected.size(),
+                  tiny_stl::set_intersection_size(a1, a2, b1, b2));
+
+        expected.clear();
+        std::set_difference(a1, a2, b1, b2, std::back_inserter(expected));
+        last = tiny_stl::set_difference(a1, a2, b1, b2, out.data());
+        EXPECT_EQ(expected, std::vector<std::uint32_t>(out.data(), last));
+
+        expected.clear();
+        std::set_union(a1, a2, b1, b2, std::back_inserter(expected));
+        last = tiny_stl::set_union(a1, a2, b1, b2, out.data());
+        EXPECT_EQ(expected, std::vector<std::uint32_t>(out.data(), last));
+
+        expected.clear();
+        std::set_symmetric_difference(a1, a2, b1, b2,
+                                      std::back_inserter(expected));
+        last = tiny_stl::set_symmetric_difference(a1, a2, b1, b2, out.data());
+        EXPECT_EQ(expected, std::vector<std::uint32_t>(out.data(), last));
+      }
+    }
+  }
+
+  // The comparator overloads, on a type without the vector compares.
+  std::vector<long> a = {9, 9, 7, 5, 5, 5, 3, 1};
+  std::vector<long> b = {9, 8, 5, 5, 2, 1, 1, 0};
+  std::vector<long> out(16);
+  auto greater = std::greater<long>();
+  const auto *a1 = a.data(), *a2 = a.data() + a.size();
+  const auto *b1 = b.data(), *b2 = b.data() + b.size();
+  auto *last =
+      tiny_stl::set_intersection(a1, a2, b1, b2, out.data(), greater);
+  EXPECT_EQ(std::vector<long>({9, 5, 5, 1}),
+            std::vector<long>(out.data(), last));
+  EXPECT_EQ(4u, tiny_stl::set_intersection_size(a1, a2, b1, b2, greater));
+  last = tiny_stl::set_difference(a1, a2, b1, b2, out.data(), greater);
+  EXPECT_EQ(std::vector<long>({9, 7, 5, 3}),
+            std::vector<long>(out.data(), last));
+  last = tiny_stl::set_union(a1, a2, b1, b2, out.data(), greater);
+  EXPECT_EQ(std::vector<long>({9, 9, 8, 7, 5, 5, 5, 3, 2, 1, 1, 0}),
+            std::vector<long>(out.data(), last));
+  last = tiny_stl::set_symmetric_difference(a1, a2, b1, b2, out.data(),
+                                            greater);
+  EXPECT_EQ(std::vector<long>({9, 8, 7, 5, 3, 2, 1, 0}),
+            std::vector<long>(out.data(), last));
+
+  // A short list against a long one, galloped with a comparator.
+  std::vector<long> small = {1000, 500, 3, -7};
+  std::vector<long> large(10000);
+  std::iota(large.rbegin(), large.rend(), 0L);
+  EXPECT_EQ(3u, tiny_stl::set_intersection_size(
+                    large.data(), large.data() + large.size(), small.data(),
+                    small.data() + small.size(), greater));
+  last = tiny_stl::set_difference(small.data(), small.data() + small.size(),
+                                  large.data(), large.data() + large.size(),
+                                  out.data(), greater);
+  EXPECT_EQ(std::vector<long>({-7}), std::vector<long>(out.data(), last));
+}
+
+TEST_F(TestAlgo, Merge_Parallel) {
+  tiny_stl::set_default_thread_count(3);
+  std::mt19937 gen(47);
+  // Big enough to be split, with many ties between the two ranges.
+  for (size_t len1 : {size_t(0), size_t(1000), size_t(300000)}) {
+    for (size_t len2 : {size_t(7), size_t(200000)}) {
+      std::uniform_int_distribution<int> dist(0, 5000);
+      std::vector<std::pair<int, int>> v(len1 + len2);
+      for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = {dist(gen), i < len1 ? 0 : 1};
+      }
+      auto by_key = [](const std::pair<int, int> &x,
+                       const std::pair<int, int> &y) {
+        return x.first < y.first;
+      };
+      auto *first = v.data();
+      auto *middle = v.data() + len1;
+      auto *last = v.data() + v.size();
+      std::sort(first, middle);
+      std::sort(middle, last);
+      std::vector<std::pair<int, int>> expected(v.size());
+      std::merge(first, middle, middle, last, expected.begin(), by_key);
+
+      std::vector<std::pair<int, int>> out(v.size());
+      EXPECT_EQ(out.data() + out.size(),
+                tiny_stl::merge(tiny_stl::par, first, middle,
+                                middle, last, out.data(), by_key));
+      EXPECT_EQ(expected, out);
+
+      tiny_stl::inplace_merge(tiny_stl::par, first, middle, last,
+                              by_key);
+      EXPECT_EQ(expected, v);
+    }
+  }
+
+  vector a(100000), b(100000), out(200000);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<int>(2 * i);
+    b[i] = static_cast<int>(2 * i + 1);
+  }
+  tiny_stl::merge(tiny_stl::par, a.data(), a.data() + a.size(),
+                  b.data(), b.data() + b.size(), out.data());
+  vector expected(200000);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(expected, out);
+
+  // A comparison which throws leaves the range as it was.
+  std::vector<std::string> strs(40000);
+  for (auto &str : strs) {
+    str = std::to_string(gen() % 100000);
+  }
+  std::sort(strs.begin(), strs.begin() + 15000);
+  std::sort(strs.begin() + 15000, strs.end());
+  const auto original = strs;
+  size_t calls = 0;
+  auto throwing_less = [&](const std::string &x, const std::string &y) {
+    if (++calls == 30000) {
+      throw std::runtime_error("less");
+    }
+    return x < y;
+  };
+  EXPECT_THROW(tiny_stl::inplace_merge(tiny_stl::par, strs.data(),
+                                       strs.data() + 15000,
+                                       strs.data() + strs.size(),
+                                       throwing_less),
+               std::runtime_error);
+  EXPECT_EQ(original, strs);
+  tiny_stl::inplace_merge(tiny_stl::par, strs.data(), strs.data() + 15000,
+                          strs.data() + strs.size(), throwing_less);
+  EXPECT_TRUE(std::is_sorted(strs.begin(), strs.end()));
+  tiny_stl::set_default_thread_count(
+      std::max(2u, std::thread::hardware_concurrency()));
+}
+
+TEST_F(TestAlgo, MultiwayMerge) {
+  std::mt19937 gen(49);
+  std::vector<vector> runs(300);
+  vector expected;
+  for (auto &run : runs) {
+    run.resize(gen() % 100);
+    for (int &x : run) {
+      x = static_cast<int>(gen() % 10000);
+    }
+    std::sort(run.begin(), run.end());
+    for (int x : run) {
+      expected.push_back(x);
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  std::vector<std::pair<const int *, const int *>> ranges;
+  for (const auto &run : runs) {
+    ranges.emplace_back(run.data(), run.data() + run.size());
+  }
+  vector out(expected.size());
+  EXPECT_EQ(out.data() + out.size(),
+            tiny_stl::multiway_merge(ranges.begin(), ranges.end(),
+                                     out.data()));
+  EXPECT_EQ(expected, out);
+
+  for (auto &run : runs) {
+    std::reverse(run.begin(), run.end());
+  }
+  std::reverse(expected.begin(), expected.end());
+  ranges.clear();
+  for (const auto &run : runs) {
+    ranges.emplace_back(run.data(), run.data() + run.size());
+  }
+  tiny_stl::multiway_merge(ranges.begin(), ranges.end(), out.data(),
+                           std::greater<int>());
+  EXPECT_EQ(expected, out);
+
+  ranges.clear();
+  EXPECT_EQ(out.data(),
+            tiny_stl::multiway_merge(ranges.begin(), ranges.end(),
+                                     out.data()));
+}
+
+TEST_F(TestAlgo, IsPermutation_Large) {
+  std::mt19937 gen(52);
+  vector a(5000);
+  for (int &x : a) {
+    x = static_cast<int>(gen() % 1000);
+  }
+  vector b = a;
+  std::shuffle(b.begin(), b.end(), gen);
+  const int *a1 = a.data(), *a2 = a.data() + a.size();
+  int *b1 = b.data(), *b2 = b.data() + b.size();
+  EXPECT_TRUE(tiny_stl::is_permutation(a1, a2, b1, b2));
+  EXPECT_TRUE(tiny_stl::is_permutation(a1, a2, b1, b2,
+                                       tiny_stl::equal_to<int>()));
+  bool result = false;
+  EXPECT_TRUE(tiny_stl::is_permutation_sorted(a1, a2, b1, b2, a.size(),
+                                              result));
+  EXPECT_TRUE(result);
+
+  // The same values with one multiplicity moved.
+  auto other = std::find_if(b1, b2, [&](int x) { return x != b[0]; });
+  *other = b[0];
+  EXPECT_FALSE(tiny_stl::is_permutation(a1, a2, b1, b2));
+  EXPECT_TRUE(tiny_stl::is_permutation_sorted(a1, a2, b1, b2, a.size(),
+                                              result));
+  EXPECT_FALSE(result);
+  EXPECT_FALSE(tiny_stl::is_permutation(a1, a2, b1, b2 - 1));
+
+  // A predicate other than `==` is still honored.
+  auto same_parity = [](int x, int y) { return (x - y) % 2 == 0; };
+  vector c(b.size());
+  for (size_t i = 0; i < b.size(); ++i) {
+    c[i] = b[i] + 2;
+  }
+  EXPECT_TRUE(tiny_stl::is_permutation(a1, a2, c.data(), c.data() + c.size(),
+                                       same_parity));
+
+  // NaN equals nothing, not even itself.
+  std::vector<double> d(100);
+  std::iota(d.begin(), d.end(), 0.0);
+  std::vector<double> e(d.rbegin(), d.rend());
+  EXPECT_TRUE(tiny_stl::is_permutation(d.data(), d.data() + d.size(),
+                                       e.data(), e.data() + e.size()));
+  d[50] = e[49] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(tiny_stl::is_permutation(d.data(), d.data() + d.size(),
+                                        e.data(), e.data() + e.size()));
+
+  // Enumerations are sorted, having no hash.
+  enum class color { red, green, blue };
+  std::vector<color> f(300), g(300);
+  for (size_t i = 0; i < f.size(); ++i) {
+    f[i] = static_cast<color>(i % 3);
+    g[i] = static_cast<color>((i + 1) % 3);
+  }
+  EXPECT_TRUE(tiny_stl::is_permutation(f.data(), f.data() + f.size(),
+                                       g.data(), g.data() + g.size()));
+  g[0] = g[1];
+  EXPECT_FALSE(tiny_stl::is_permutation(f.data(), f.data() + f.size(),
+                                        g.data(), g.data() + g.size()));
+}
+
+TEST_F(TestAlgo, IsPermutation_LongDouble) {
+  // The padding of `long double` takes no part in the hashed comparison.
+  std::vector<long double> a(40);
+  std::iota(a.begin(), a.end(), 0.5l);
+  std::vector<long double> b(a.rbegin(), a.rend());
+  const size_t value_bytes =
+      std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(b[0]);
+  for (size_t i = 0; i < b.size(); ++i) {
+    auto *bytes = reinterpret_cast<unsigned char *>(&b[i]);
+    for (size_t k = value_bytes; k < sizeof(b[i]); ++k) {
+      bytes[k] = static_cast<unsigned char>(i * 7 + k);
+    }
+  }
+  EXPECT_TRUE(tiny_stl::is_permutation(a.data(), a.data() + a.size(),
+                                       b.data(), b.data() + b.size()));
+  b[3] = 100.5l;
+  EXPECT_FALSE(tiny_stl::is_permutation(a.data(), a.data() + a.size(),
+                                        b.data(), b.data() + b.size()));
+}
+
 #endif // !TINY_STL__TEST__TEST_ALGO_HPP
\ No newline at end of file
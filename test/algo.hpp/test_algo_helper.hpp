@@ -92,6 +92,8 @@ public:
       _data[_size++] = val;
     }
     void pop_back() { --_size; }
+    int *data() { return _data; }
+    const int *data() const { return _data; }
     int *begin() { return _data; }
     int *end() { return _data + _size; }
     const int *begin() const { return _data; }
@@ -3,9 +3,54 @@
 
 #include "algobase.hpp"
 
+#include <cmath>
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
 
+static int *arr_ptr_helper() {
+  static int value = 0;
+  return &value;
+}
+
+namespace {
+
+// A wrapped pointer opting in `contiguous_iterator_tag`, it has to be
+// unwrapped by `to_address` to reach the `memmove` paths.
+template <class T>
+struct contiguous_wrapper
+    : tiny_stl::iterator<tiny_stl::contiguous_iterator_tag, T> {
+  T *ptr;
+  explicit contiguous_wrapper(T *p = nullptr) : ptr(p) {}
+  T &operator*() const { return *ptr; }
+  T *operator->() const { return ptr; }
+  contiguous_wrapper &operator++() {
+    ++ptr;
+    return *this;
+  }
+  contiguous_wrapper &operator--() {
+    --ptr;
+    return *this;
+  }
+  contiguous_wrapper operator+(ptrdiff_t n) const {
+    return contiguous_wrapper(ptr + n);
+  }
+  contiguous_wrapper operator-(ptrdiff_t n) const {
+    return contiguous_wrapper(ptr - n);
+  }
+  ptrdiff_t operator-(const contiguous_wrapper &other) const {
+    return ptr - other.ptr;
+  }
+  bool operator==(const contiguous_wrapper &other) const {
+    return ptr == other.ptr;
+  }
+  bool operator!=(const contiguous_wrapper &other) const {
+    return ptr != other.ptr;
+  }
+};
+
+} // namespace
+
 TEST(Algobase, Max) {
   int left = 3, right = 4;
   std::string str1 = "1", str2 = "2";
@@ -74,6 +119,91 @@ TEST(Algobase, UncheckedCopy_TrailingCopyConstructible) {
   }
 }
 
+TEST(Algobase, CopyNt) {
+  // Cover the aligned body, the unaligned head and the tail.
+  const size_t n = 1000;
+  std::unique_ptr<char[]> src(new char[n]);
+  std::unique_ptr<char[]> dest(new char[n + 64]);
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = static_cast<char>(i * 7);
+  }
+  for (size_t offset = 0; offset < 64; offset += 13) {
+    for (size_t len : {size_t(0), size_t(5), size_t(100), n}) {
+      EXPECT_EQ(tiny_stl::copy_nt(src.get(), src.get() + len,
+                                  dest.get() + offset),
+                dest.get() + offset + len);
+      for (size_t i = 0; i < len; ++i) {
+        ASSERT_EQ(src[i], dest[offset + i]);
+      }
+    }
+  }
+  std::string strs[3] = {"a", "b", "c"};
+  std::string strs_dest[3];
+  EXPECT_EQ(tiny_stl::copy_nt(strs, strs + 3, strs_dest), strs_dest + 3);
+  EXPECT_EQ("c", strs_dest[2]);
+}
+
+TEST(Algobase, UncheckedCopy_ContiguousIterator) {
+  int arr1[] = {1, 2, 3, 4, 5};
+  int arr2[5] = {};
+  using wrapper = contiguous_wrapper<int>;
+  EXPECT_EQ(tiny_stl::copy(wrapper(arr1), wrapper(arr1 + 5), wrapper(arr2)),
+            wrapper(arr2 + 5));
+  EXPECT_EQ(tiny_stl::copy_backward(wrapper(arr1), wrapper(arr1 + 3),
+                                    arr2 + 5),
+            arr2 + 2);
+  EXPECT_EQ(tiny_stl::move(arr1, arr1 + 2, wrapper(arr2)), wrapper(arr2 + 2));
+  int expected[] = {1, 2, 1, 2, 3};
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(expected[i], arr2[i]);
+  }
+
+  std::string strs[2] = {"a", "b"};
+  std::string strs_dest[2];
+  tiny_stl::copy(contiguous_wrapper<std::string>(strs),
+                 contiguous_wrapper<std::string>(strs + 2),
+                 contiguous_wrapper<std::string>(strs_dest));
+  EXPECT_EQ("b", strs_dest[1]);
+}
+
+TEST(Algobase, UncheckedCopy_ReverseIterator) {
+  using rev = tiny_stl::reverse_iterator<int *>;
+  static_assert(tiny_stl::is_reverse_memmovable_v<rev, rev>);
+  int arr1[] = {1, 2, 3, 4, 5};
+  int arr2[5] = {};
+  // Copy arr1 reversed into arr2 reversed, the order is kept.
+  EXPECT_EQ(tiny_stl::copy(rev(arr1 + 5), rev(arr1), rev(arr2 + 5)),
+            rev(arr2));
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(arr1[i], arr2[i]);
+  }
+  // Overlapping ranges, shift right by one through reverse iterators.
+  int arr3[] = {1, 2, 3, 4, 5, 0};
+  tiny_stl::copy(rev(arr3 + 5), rev(arr3), rev(arr3 + 6));
+  int expected[] = {1, 1, 2, 3, 4, 5};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(expected[i], arr3[i]);
+  }
+  // Backward through reverse iterators, shift left by one.
+  EXPECT_EQ(tiny_stl::move_backward(rev(arr3 + 6), rev(arr3 + 1), rev(arr3)),
+            rev(arr3 + 5));
+  int expected2[] = {1, 2, 3, 4, 5, 5};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(expected2[i], arr3[i]);
+  }
+}
+
+TEST(Algobase, FillN_ReverseIterator) {
+  int arr[6] = {};
+  using rev = tiny_stl::reverse_iterator<int *>;
+  EXPECT_EQ(tiny_stl::fill_n(rev(arr + 6), 4, 7), rev(arr + 2));
+  tiny_stl::fill_n(contiguous_wrapper<int>(arr), 1, 9);
+  int expected[] = {9, 0, 7, 7, 7, 7};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(expected[i], arr[i]);
+  }
+}
+
 TEST(Algobase, UncheckedCopyBackwardCat_Bidirectional) {
   int arr1[] = {1, 2, 3, 4, 5};
   int arr2[5];
@@ -211,6 +341,67 @@ TEST(Algobase, UncheckedFillN_1Byte) {
   }
 }
 
+TEST(Algobase, UncheckedFillN_Zero) {
+  double arr[5] = {1, 2, 3, 4, 5};
+  tiny_stl::unchecked_fill_n(arr, 5, 0);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(arr[i], 0.0);
+  }
+  tiny_stl::unchecked_fill_n(arr, 5, -0.0);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(std::signbit(arr[i]));
+  }
+  int *ptrs[3] = {arr_ptr_helper(), arr_ptr_helper(), arr_ptr_helper()};
+  tiny_stl::fill(ptrs, ptrs + 3, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(ptrs[i], nullptr);
+  }
+}
+
+TEST(Algobase, UncheckedFillN_Broadcast) {
+  struct Pair {
+    int a;
+    float b;
+  };
+  struct Quad {
+    int a, b, c, d;
+  };
+  // Sizes around the vector width cover the unrolled body and the tail.
+  for (size_t n : {1, 3, 7, 8, 15, 33, 130}) {
+    std::unique_ptr<short[]> shorts(new short[n + 1]);
+    std::unique_ptr<double[]> doubles(new double[n + 1]);
+    std::unique_ptr<Pair[]> pairs(new Pair[n + 1]);
+    std::unique_ptr<Quad[]> quads(new Quad[n + 1]);
+    shorts[n] = 0;
+    quads[n] = Quad{0, 0, 0, 0};
+    EXPECT_EQ(tiny_stl::unchecked_fill_n(shorts.get(), n, short(-2)),
+              shorts.get() + n);
+    EXPECT_EQ(tiny_stl::fill_n(doubles.get(), n, 1.5), doubles.get() + n);
+    tiny_stl::fill(pairs.get(), pairs.get() + n, Pair{1, 2.5f});
+    tiny_stl::fill_n(quads.get(), n, Quad{1, 2, 3, 4});
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(-2, shorts[i]);
+      ASSERT_EQ(1.5, doubles[i]);
+      ASSERT_EQ(1, pairs[i].a);
+      ASSERT_EQ(2.5f, pairs[i].b);
+      ASSERT_EQ(4, quads[i].d);
+    }
+    EXPECT_EQ(0, shorts[n]);
+    EXPECT_EQ(0, quads[n].a);
+  }
+}
+
+TEST(Algobase, AllZeroBytes) {
+  struct NotOptedIn {
+    int a;
+  };
+  EXPECT_TRUE(tiny_stl::all_zero_bytes(0));
+  EXPECT_TRUE(tiny_stl::all_zero_bytes(0.0));
+  EXPECT_FALSE(tiny_stl::all_zero_bytes(-0.0));
+  EXPECT_FALSE(tiny_stl::all_zero_bytes(1L));
+  EXPECT_FALSE(tiny_stl::all_zero_bytes(NotOptedIn{0}));
+}
+
 TEST(Algobase, FillCat_ForwardIterator) {
   int arr[5];
   tiny_stl::fill_cat(arr, arr + 5, 1, tiny_stl::forward_iterator_tag());
@@ -296,4 +487,59 @@ TEST(Algobase, Mismatch) {
   EXPECT_EQ(tiny_stl::mismatch(arr3, arr3 + 5, arr4).second, arr4 + 4);
 }
 
+TEST(Algobase, MismatchBytes) {
+  unsigned char a[100] = {};
+  unsigned char b[100] = {};
+  EXPECT_EQ(100, tiny_stl::mismatch_bytes(a, b, 100));
+  // Cover the vector lanes, the 8-byte words and the last bytes.
+  for (size_t i : {0, 7, 15, 16, 31, 40, 63, 90, 99}) {
+    b[i] = 1;
+    EXPECT_EQ(i, tiny_stl::mismatch_bytes(a, b, 100));
+    EXPECT_EQ(i, tiny_stl::mismatch_bytes(a, b, i + 1));
+    EXPECT_EQ(i, tiny_stl::mismatch_bytes(a, b, i));
+    b[i] = 0;
+  }
+}
+
+TEST(Algobase, Equal_BitwiseComparable) {
+  unsigned arr1[70];
+  unsigned arr2[70];
+  for (unsigned i = 0; i < 70; ++i) {
+    arr1[i] = arr2[i] = i * 31;
+  }
+  EXPECT_TRUE(tiny_stl::equal(arr1, arr1 + 70, arr2));
+  EXPECT_TRUE(tiny_stl::equal(arr1, arr1, arr2));
+  arr2[69] = 0;
+  EXPECT_FALSE(tiny_stl::equal(arr1, arr1 + 70, arr2));
+  EXPECT_TRUE(tiny_stl::equal(arr1, arr1 + 69, arr2));
+}
+
+TEST(Algobase, Mismatch_BitwiseComparable) {
+  long arr1[50] = {};
+  long arr2[50] = {};
+  EXPECT_EQ(tiny_stl::mismatch(arr1, arr1 + 50, arr2).first, arr1 + 50);
+  arr2[33] = -1;
+  auto result = tiny_stl::mismatch(arr1, arr1 + 50, arr2);
+  EXPECT_EQ(result.first, arr1 + 33);
+  EXPECT_EQ(result.second, arr2 + 33);
+}
+
+TEST(Algobase, LexicographicalCompare_BitwiseComparable) {
+  // The order of the elements is not the order of their bytes.
+  int arr1[40] = {};
+  int arr2[40] = {};
+  arr1[20] = -1;
+  arr2[20] = 256;
+  EXPECT_TRUE(tiny_stl::lexicographical_compare(arr1, arr1 + 40, arr2,
+                                                arr2 + 40));
+  EXPECT_FALSE(tiny_stl::lexicographical_compare(arr2, arr2 + 40, arr1,
+                                                 arr1 + 40));
+  EXPECT_FALSE(tiny_stl::lexicographical_compare(arr1, arr1 + 40, arr1,
+                                                 arr1 + 40));
+  EXPECT_TRUE(tiny_stl::lexicographical_compare(arr1, arr1 + 10, arr1,
+                                                arr1 + 40));
+  EXPECT_FALSE(tiny_stl::lexicographical_compare(arr1, arr1 + 40, arr1,
+                                                 arr1 + 10));
+}
+
 #endif // ! TINY_STL__TEST__TEST_ALGOBASE_HPP
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef TINY_STL__TEST__TEST_EXECUTION_HPP
+#define TINY_STL__TEST__TEST_EXECUTION_HPP
+
+#include "execution.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(Execution, IsExecutionPolicy) {
+  EXPECT_TRUE(tiny_stl::is_execution_policy_v<tiny_stl::sequenced_policy>);
+  EXPECT_TRUE(tiny_stl::is_execution_policy_v<const tiny_stl::parallel_policy &>);
+  EXPECT_FALSE(tiny_stl::is_execution_policy_v<int>);
+}
+
+TEST(Execution, ThreadPool_Submit) {
+  std::atomic<int> sum{0};
+  {
+    tiny_stl::thread_pool pool(2);
+    for (int i = 1; i <= 100; ++i) {
+      pool.submit([&sum, i] { sum += i; });
+    }
+  }
+  EXPECT_EQ(5050, sum);
+}
+
+TEST(Execution, ThreadPool_NestedSubmit) {
+  // Tasks submitted by the workers go to their own deques and get stolen.
+  std::atomic<int> sum{0};
+  {
+    tiny_stl::thread_pool pool(3);
+    for (int i = 0; i < 10; ++i) {
+      pool.submit([&pool, &sum] {
+        for (int j = 0; j < 10; ++j) {
+          pool.submit([&sum] { ++sum; });
+        }
+      });
+    }
+  }
+  EXPECT_EQ(100, sum);
+}
+
+TEST(Execution, ThreadPool_NoWorker) {
+  tiny_stl::thread_pool pool(0);
+  int sum = 0;
+  pool.submit([&sum] { sum += 1; });
+  pool.submit([&sum] { sum += 2; });
+  EXPECT_TRUE(pool.try_run_one());
+  EXPECT_TRUE(pool.try_run_one());
+  EXPECT_FALSE(pool.try_run_one());
+  EXPECT_EQ(3, sum);
+}
+
+TEST(Execution, SetDefaultThreadCount) {
+  tiny_stl::set_default_thread_count(4);
+  EXPECT_EQ(3, tiny_stl::default_thread_pool().size());
+  EXPECT_EQ(4, tiny_stl::parallel_chunk_count(1000, 1));
+  tiny_stl::set_default_thread_count(1);
+  EXPECT_EQ(1, tiny_stl::parallel_chunk_count(1000, 1));
+  int hits[4] = {};
+  tiny_stl::parallel_for(4, [&hits](size_t i) { ++hits[i]; });
+  EXPECT_EQ(1, hits[3]);
+  tiny_stl::set_default_thread_count(
+      std::max(2u, std::thread::hardware_concurrency()));
+}
+
+TEST(Execution, ChunkBegin) {
+  EXPECT_EQ(0, tiny_stl::chunk_begin(10, 3, 0));
+  EXPECT_EQ(4, tiny_stl::chunk_begin(10, 3, 1));
+  EXPECT_EQ(7, tiny_stl::chunk_begin(10, 3, 2));
+  EXPECT_EQ(10, tiny_stl::chunk_begin(10, 3, 3));
+}
+
+TEST(Execution, ParallelFor) {
+  int hits[16] = {};
+  tiny_stl::parallel_for(16, [&hits](size_t i) { ++hits[i]; });
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(1, hits[i]);
+  }
+}
+
+TEST(Execution, ParallelFor_Exception) {
+  std::atomic<int> finished{0};
+  EXPECT_THROW(tiny_stl::parallel_for(8,
+                                      [&finished](size_t i) {
+                                        if (i == 5) {
+                                          throw std::runtime_error("chunk");
+                                        }
+                                        ++finished;
+                                      }),
+               std::runtime_error);
+  EXPECT_EQ(7, finished);
+}
+
+TEST(Execution, ParallelFor_Nested) {
+  std::atomic<int> sum{0};
+  tiny_stl::parallel_for(4, [&sum](size_t) {
+    tiny_stl::parallel_for(4, [&sum](size_t j) { sum += static_cast<int>(j); });
+  });
+  EXPECT_EQ(24, sum);
+}
+
+#endif // !TINY_STL__TEST__TEST_EXECUTION_HPP
@@ -0,0 +1,123 @@
+#ifndef TINY_STL__TEST__TEST_EXTERNAL_SORT_HPP
+#define TINY_STL__TEST__TEST_EXTERNAL_SORT_HPP
+
+#include "external_sort.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(ExternalSort, InMemory) {
+  std::vector<int> v = {5, 3, 9, 1, 1, 7};
+  std::vector<int> out(v.size());
+  EXPECT_EQ(out.data() + out.size(),
+            tiny_stl::external_sort(v.data(), v.data() + v.size(), out.data(),
+                                    1 << 20));
+  EXPECT_EQ(std::vector<int>({1, 1, 3, 5, 7, 9}), out);
+
+  EXPECT_EQ(out.data(),
+            tiny_stl::external_sort(v.data(), v.data(), out.data(), 1 << 20));
+}
+
+TEST(ExternalSort, Runs) {
+  // A budget of 1000 records for 100000 records gives 200 runs.
+  std::mt19937 gen(50);
+  for (size_t n : {size_t(999), size_t(1001), size_t(100000)}) {
+    std::vector<std::uint32_t> v(n);
+    for (auto &x : v) {
+      x = static_cast<std::uint32_t>(gen() % 5000);
+    }
+    std::vector<std::uint32_t> out(n);
+    tiny_stl::external_sort(v.data(), v.data() + n, out.data(),
+                            1000 * sizeof(std::uint32_t));
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, out);
+
+    tiny_stl::external_sort(v.data(), v.data() + n, out.data(),
+                            1000 * sizeof(std::uint32_t),
+                            std::greater<std::uint32_t>());
+    std::reverse(v.begin(), v.end());
+    EXPECT_EQ(v, out);
+  }
+}
+
+TEST(ExternalSort, SpillDir) {
+  std::vector<int> v(5000);
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = static_cast<int>((i * 7919) % v.size());
+  }
+  std::vector<int> out(v.size());
+  const std::string dir = testing::TempDir();
+  tiny_stl::external_sort(v.data(), v.data() + v.size(), out.data(),
+                          100 * sizeof(int), std::less<int>(), dir.c_str());
+  EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+
+  // The runs go to the directory given, not to the system one.
+  EXPECT_THROW(tiny_stl::external_sort(v.data(), v.data() + v.size(),
+                                       out.data(), 100 * sizeof(int),
+                                       std::less<int>(), "/nonexistent/dir"),
+               std::runtime_error);
+}
+
+TEST(ExternalSort, File) {
+  struct record {
+    std::uint64_t key;
+    std::uint32_t payload;
+  };
+  const std::string input = testing::TempDir() + "tiny_stl_external_in";
+  const std::string output = testing::TempDir() + "tiny_stl_external_out";
+  std::mt19937_64 gen(51);
+  std::vector<record> records(50000);
+  for (size_t i = 0; i < records.size(); ++i) {
+    records[i] = {gen() % 100000, static_cast<std::uint32_t>(i)};
+  }
+  {
+    tiny_stl::external_file file(input.c_str(), "wb");
+    file.write(records.data(), records.size());
+  }
+  auto by_key = [](const record &x, const record &y) { return x.key < y.key; };
+  tiny_stl::external_sort_file<record>(input.c_str(), output.c_str(),
+                                       64 * 1024, by_key);
+
+  std::vector<record> sorted(records.size() + 1);
+  {
+    tiny_stl::external_file file(output.c_str(), "rb");
+    EXPECT_EQ(records.size(), file.read(sorted.data(), sorted.size()));
+  }
+  sorted.pop_back();
+  std::stable_sort(records.begin(), records.end(), by_key);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].key, sorted[i].key);
+  }
+  // Every record is there once.
+  std::vector<std::uint32_t> payloads;
+  for (const auto &r : sorted) {
+    payloads.push_back(r.payload);
+  }
+  std::sort(payloads.begin(), payloads.end());
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    EXPECT_EQ(i, payloads[i]);
+  }
+
+  // A truncated record is an error.
+  {
+    tiny_stl::external_file file(input.c_str(), "wb");
+    file.write("abc", 3);
+  }
+  EXPECT_THROW(tiny_stl::external_sort_file<std::uint32_t>(
+                   input.c_str(), output.c_str(), 1 << 16),
+               std::runtime_error);
+  EXPECT_THROW(tiny_stl::external_file("/nonexistent/tiny_stl", "rb"),
+               std::runtime_error);
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+}
+
+#endif // !TINY_STL__TEST__TEST_EXTERNAL_SORT_HPP
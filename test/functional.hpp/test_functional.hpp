@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 TEST(Functional, Plus) {
   tiny_stl::plus<int> plus;
   EXPECT_EQ(plus(1, 2), 3);
@@ -170,4 +172,19 @@ TEST(Functional, Hash_Float) {
   EXPECT_EQ(12299727721494879672, long_double_hash_val);
 }
 
+TEST(Functional, Hash_LongDouble_Padding) {
+  // Equal values hash equally, whatever the padding after their bytes holds.
+  long double a = 1.5l;
+  long double b = 1.5l;
+  auto *bytes = reinterpret_cast<unsigned char *>(&b);
+  const size_t value_bytes =
+      std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(b);
+  for (size_t i = value_bytes; i < sizeof(b); ++i) {
+    bytes[i] = 0xA5;
+  }
+  ASSERT_EQ(a, b);
+  tiny_stl::hash<long double> hash_long_double;
+  EXPECT_EQ(hash_long_double(a), hash_long_double(b));
+}
+
 #endif // ! TINY_STL__TEST__TEST_FUNCTIONAL_HPP
\ No newline at end of file
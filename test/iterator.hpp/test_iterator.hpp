@@ -342,4 +342,27 @@ TEST_F(TestReverseIterator, OperatorArrow) {
   
 }
 
+TEST(Test_Iterator, IsContiguousIterator) {
+  using tiny_stl::is_contiguous_iterator_v;
+  using contiguous =
+      tiny_stl::iterator<tiny_stl::contiguous_iterator_tag, int>;
+  EXPECT_TRUE(is_contiguous_iterator_v<int *>);
+  EXPECT_TRUE(is_contiguous_iterator_v<const int *>);
+  EXPECT_TRUE(is_contiguous_iterator_v<contiguous>);
+  EXPECT_TRUE(tiny_stl::is_random_iterator<contiguous>::value);
+  EXPECT_FALSE((is_contiguous_iterator_v<
+                tiny_stl::iterator<tiny_stl::random_access_iterator_tag, int>>));
+  EXPECT_FALSE(
+      is_contiguous_iterator_v<tiny_stl::reverse_iterator<contiguous>>);
+}
+
+TEST(Test_Iterator, ToAddress) {
+  int arr[3] = {};
+  EXPECT_EQ(tiny_stl::to_address(arr + 1), arr + 1);
+  tiny_stl::reverse_iterator<int *> rev(arr + 3);
+  EXPECT_EQ(tiny_stl::to_address(rev), arr + 2);
+  EXPECT_TRUE(tiny_stl::is_reverse_iterator<decltype(rev)>::value);
+  EXPECT_FALSE(tiny_stl::is_reverse_iterator<int *>::value);
+}
+
 #endif // !TINY_STL__TEST__TEST_ITERATOR_HPP
\ No newline at end of file
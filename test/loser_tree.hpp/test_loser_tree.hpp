@@ -0,0 +1,94 @@
+#ifndef TINY_STL__TEST__TEST_LOSER_TREE_HPP
+#define TINY_STL__TEST__TEST_LOSER_TREE_HPP
+
+#include "loser_tree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+TEST(LoserTree, Empty) {
+  tiny_stl::loser_tree<const int *> none;
+  EXPECT_TRUE(none.empty());
+  EXPECT_EQ(0u, none.sources());
+
+  std::vector<std::pair<const int *, const int *>> sources(3);
+  tiny_stl::loser_tree<const int *> exhausted(sources.begin(), sources.end());
+  EXPECT_TRUE(exhausted.empty());
+  EXPECT_EQ(3u, exhausted.sources());
+}
+
+TEST(LoserTree, Merge_Stable) {
+  // Elements are (key, source), equal keys must come out by source and then
+  // by their order in the source.
+  std::mt19937 gen(48);
+  for (size_t k : {1, 2, 3, 5, 8, 13, 100}) {
+    std::vector<std::vector<std::pair<int, size_t>>> runs(k);
+    std::vector<std::pair<int, size_t>> expected;
+    for (size_t s = 0; s < k; ++s) {
+      runs[s].resize(gen() % 50);
+      for (auto &x : runs[s]) {
+        x = {static_cast<int>(gen() % 20), s};
+      }
+      std::sort(runs[s].begin(), runs[s].end());
+      expected.insert(expected.end(), runs[s].begin(), runs[s].end());
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto &x, const auto &y) {
+                       return x.first < y.first;
+                     });
+
+    using iter = const std::pair<int, size_t> *;
+    auto by_key = [](const std::pair<int, size_t> &x,
+                     const std::pair<int, size_t> &y) {
+      return x.first < y.first;
+    };
+    std::vector<std::pair<iter, iter>> sources;
+    for (const auto &run : runs) {
+      sources.emplace_back(run.data(), run.data() + run.size());
+    }
+    tiny_stl::loser_tree<iter, decltype(by_key)> tree(sources.begin(),
+                                                      sources.end(), by_key);
+    std::vector<std::pair<int, size_t>> merged;
+    for (; !tree.empty(); tree.pop()) {
+      EXPECT_EQ(tree.top().second, tree.source());
+      merged.push_back(tree.top());
+    }
+    EXPECT_EQ(expected, merged);
+  }
+}
+
+TEST(LoserTree, Streams) {
+  // The sources are read lazily through input iterators.
+  std::istringstream a("1 4 9 16"), b("2 3 5 7 11 13"), c(""), d("0 100");
+  using iter = std::istream_iterator<int>;
+  std::vector<std::pair<iter, iter>> sources = {
+      {iter(a), iter()}, {iter(b), iter()}, {iter(c), iter()},
+      {iter(d), iter()}};
+  tiny_stl::loser_tree<iter> tree(sources.begin(), sources.end());
+  std::vector<int> merged;
+  for (; !tree.empty(); tree.pop()) {
+    merged.push_back(tree.top());
+  }
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 7, 9, 11, 13, 16, 100}),
+            merged);
+
+  // Sorted in descending order.
+  std::istringstream e("9 5 1"), f("8 5 2");
+  sources = {{iter(e), iter()}, {iter(f), iter()}};
+  tiny_stl::loser_tree<iter, std::greater<int>> descending(sources.begin(),
+                                                           sources.end());
+  merged.clear();
+  for (; !descending.empty(); descending.pop()) {
+    merged.push_back(descending.top());
+  }
+  EXPECT_EQ(std::vector<int>({9, 8, 5, 5, 2, 1}), merged);
+}
+
+#endif // !TINY_STL__TEST__TEST_LOSER_TREE_HPP
@@ -3,6 +3,7 @@
 #include "algobase.hpp/test_algobase.hpp"
 #include "allocator.hpp"
 #include "construct.hpp/test_construct.hpp"
+#include "execution.hpp/test_execution.hpp"
 #include "iterator.hpp/test_iterator.hpp"
 #include "memory.hpp/test_memory.hpp"
 #include "type_traits.hpp/test_type_traits.hpp"
@@ -11,6 +12,13 @@
 #include "heap_algo.hpp/test_heap_algo.hpp"
 #include "functional.hpp/test_functional.hpp"
 #include "algo.hpp/test_algo.hpp"
+#include "object_pool.hpp/test_object_pool.hpp"
+#include "searcher.hpp/test_searcher.hpp"
+#include "search_index.hpp/test_search_index.hpp"
+#include "loser_tree.hpp/test_loser_tree.hpp"
+#include "external_sort.hpp/test_external_sort.hpp"
+#include "random.hpp/test_random.hpp"
+#include "vector.hpp/test_vector.hpp"
 
 int main(int arc, char *argv[]) {
   testing::InitGoogleTest(&arc, argv);
@@ -0,0 +1,103 @@
+#ifndef TINY_STL__TEST__TEST_OBJECT_POOL_HPP
+#define TINY_STL__TEST__TEST_OBJECT_POOL_HPP
+
+#include "object_pool.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Counted {
+  static int constructed;
+  static int destroyed;
+  std::string buffer;
+  Counted() { ++constructed; }
+  ~Counted() { ++destroyed; }
+};
+
+int Counted::constructed = 0;
+int Counted::destroyed = 0;
+
+struct ClearBuffer {
+  void operator()(Counted &obj) const { obj.buffer.clear(); }
+};
+
+} // namespace
+
+TEST(ObjectPool, AcquireRelease_Recycle) {
+  Counted::constructed = Counted::destroyed = 0;
+  {
+    tiny_stl::object_pool<Counted> pool;
+    Counted *obj = pool.acquire();
+    obj->buffer = "message";
+    pool.release(obj);
+    EXPECT_EQ(1, pool.idle());
+    EXPECT_EQ(obj, pool.acquire());
+    EXPECT_EQ("message", obj->buffer);
+    EXPECT_EQ(1, Counted::constructed);
+    EXPECT_EQ(0, Counted::destroyed);
+    pool.release(obj);
+  }
+  EXPECT_EQ(1, Counted::destroyed);
+}
+
+TEST(ObjectPool, Release_ResetHook) {
+  tiny_stl::object_pool<Counted, ClearBuffer> pool;
+  Counted *obj = pool.acquire();
+  obj->buffer.assign(100, 'x');
+  const auto cap = obj->buffer.capacity();
+  pool.release(obj);
+  obj = pool.acquire();
+  EXPECT_TRUE(obj->buffer.empty());
+  EXPECT_EQ(cap, obj->buffer.capacity());
+  pool.release(obj);
+}
+
+TEST(ObjectPool, Reserve) {
+  Counted::constructed = Counted::destroyed = 0;
+  {
+    tiny_stl::object_pool<Counted> pool(10);
+    EXPECT_EQ(10, pool.idle());
+    EXPECT_EQ(10, pool.size());
+    EXPECT_EQ(10, Counted::constructed);
+    pool.reserve(5);
+    EXPECT_EQ(10, pool.size());
+    pool.reserve(20);
+    EXPECT_EQ(20, pool.idle());
+    std::vector<Counted *> objs;
+    for (int i = 0; i < 50; ++i) {
+      objs.push_back(pool.acquire());
+    }
+    EXPECT_EQ(0, pool.idle());
+    EXPECT_EQ(50, pool.size());
+    for (auto obj : objs) {
+      pool.release(obj);
+    }
+    EXPECT_EQ(50, pool.idle());
+  }
+  EXPECT_EQ(50, Counted::destroyed);
+}
+
+TEST(ObjectPool, Concurrent) {
+  tiny_stl::concurrent_object_pool<std::string> pool;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool] {
+      for (int i = 0; i < 1000; ++i) {
+        std::string *str = pool.acquire();
+        str->assign("value");
+        pool.release(str);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool.size(), pool.idle());
+  EXPECT_LE(pool.size(), 4);
+}
+
+#endif // !TINY_STL__TEST__TEST_OBJECT_POOL_HPP
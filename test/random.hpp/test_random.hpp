@@ -0,0 +1,119 @@
+#ifndef TINY_STL__TEST__TEST_RANDOM_HPP
+#define TINY_STL__TEST__TEST_RANDOM_HPP
+
+#include "random.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Draw `rounds` integers in [0, range) from `g`, and check that every value
+// shows up within five standard deviations of its expected count.
+template <class URBG>
+void check_uniform_bounded(URBG g, std::uint64_t range, size_t rounds) {
+  std::vector<size_t> counts(range);
+  for (size_t i = 0; i < rounds; ++i) {
+    const std::uint64_t x = tiny_stl::uniform_bounded(g, range);
+    ASSERT_LT(x, range);
+    ++counts[x];
+  }
+  const double expected = static_cast<double>(rounds) / range;
+  for (size_t count : counts) {
+    EXPECT_NEAR(expected, static_cast<double>(count), 5 * std::sqrt(expected));
+  }
+}
+
+} // namespace
+
+TEST(Random, Splitmix64) {
+  tiny_stl::splitmix64 g(1234567);
+  EXPECT_EQ(6457827717110365317ull, g());
+  EXPECT_EQ(3203168211198807973ull, g());
+  EXPECT_EQ(9817491932198370423ull, g());
+  EXPECT_EQ(4593380528125082431ull, g());
+  EXPECT_EQ(16408922859458223821ull, g());
+}
+
+TEST(Random, Pcg32) {
+  tiny_stl::pcg32 g(42, 54);
+  EXPECT_EQ(2707161783u, g());
+  EXPECT_EQ(2068313097u, g());
+  EXPECT_EQ(3122475824u, g());
+  EXPECT_EQ(2211639955u, g());
+  EXPECT_EQ(3215226955u, g());
+
+  // Jumping ahead lands where stepping does.
+  tiny_stl::pcg32 stepped(7, 3);
+  tiny_stl::pcg32 jumped(7, 3);
+  for (int i = 0; i < 1000; ++i) {
+    stepped();
+  }
+  jumped.discard(1000);
+  EXPECT_EQ(stepped, jumped);
+  EXPECT_EQ(stepped(), jumped());
+  EXPECT_NE(tiny_stl::pcg32(7, 3)(), tiny_stl::pcg32(7, 4)());
+}
+
+TEST(Random, Xoshiro256StarStar) {
+  tiny_stl::xoshiro256starstar a(2024);
+  tiny_stl::xoshiro256starstar b(2024);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(a(), b());
+  }
+  b.seed(2025);
+  EXPECT_NE(a, b);
+
+  // A jumped stream does not run into the first numbers of the original.
+  tiny_stl::xoshiro256starstar jumped = a;
+  jumped.jump();
+  std::vector<std::uint64_t> head;
+  for (int i = 0; i < 1000; ++i) {
+    head.push_back(a());
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(head.end(), std::find(head.begin(), head.end(), jumped()));
+  }
+
+  // The output bits are balanced.
+  size_t ones = 0;
+  for (int i = 0; i < 10000; ++i) {
+    ones += static_cast<size_t>(__builtin_popcountll(a()));
+  }
+  EXPECT_NEAR(320000.0, static_cast<double>(ones), 3000.0);
+}
+
+TEST(Random, UniformBounded) {
+  check_uniform_bounded(tiny_stl::xoshiro256starstar(1), 7, 70000);
+  check_uniform_bounded(tiny_stl::splitmix64(2), 100, 100000);
+  check_uniform_bounded(tiny_stl::pcg32(3), 3, 30000);
+  check_uniform_bounded(std::minstd_rand(4), 10, 100000);
+
+  tiny_stl::xoshiro256starstar g(5);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(0u, tiny_stl::uniform_bounded(g, 1));
+  }
+  // Ranges wider than a 32-bit engine take two draws.
+  tiny_stl::pcg32 narrow(6);
+  const std::uint64_t wide = (std::uint64_t(1) << 40) + 5;
+  bool high = false;
+  for (int i = 0; i < 100; ++i) {
+    const std::uint64_t x = tiny_stl::uniform_bounded(narrow, wide);
+    EXPECT_LT(x, wide);
+    high = high || x >= (std::uint64_t(1) << 32);
+  }
+  EXPECT_TRUE(high);
+}
+
+TEST(Random, ThreadRandomEngine) {
+  auto &engine = tiny_stl::thread_random_engine();
+  EXPECT_EQ(&engine, &tiny_stl::thread_random_engine());
+  EXPECT_NE(engine(), engine());
+  EXPECT_NE(tiny_stl::random_seed(), tiny_stl::random_seed());
+}
+
+#endif // !TINY_STL__TEST__TEST_RANDOM_HPP
@@ -0,0 +1,86 @@
+#ifndef TINY_STL__TEST__TEST_SEARCH_INDEX_HPP
+#define TINY_STL__TEST__TEST_SEARCH_INDEX_HPP
+
+#include "search_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Build an index over `keys` after sorting them, and compare every query of
+// `queries` with `std::lower_bound` and `std::upper_bound`.
+template <class T>
+void check_search_index(std::vector<T> keys, const std::vector<T> &queries) {
+  std::sort(keys.begin(), keys.end());
+  tiny_stl::static_search_index<T> index(keys.begin(), keys.end());
+  EXPECT_EQ(keys.size(), index.size());
+  for (const T &query : queries) {
+    const auto lower = static_cast<size_t>(
+        std::lower_bound(keys.begin(), keys.end(), query) - keys.begin());
+    const auto upper = static_cast<size_t>(
+        std::upper_bound(keys.begin(), keys.end(), query) - keys.begin());
+    EXPECT_EQ(lower, index.lower_bound(query));
+    EXPECT_EQ(upper, index.upper_bound(query));
+    EXPECT_EQ(lower != upper, index.contains(query));
+  }
+}
+
+template <class T> void check_search_index_sizes() {
+  std::mt19937_64 gen(40);
+  for (size_t n : {0, 1, 2, 7, 8, 15, 16, 17, 100, 289, 5000, 70000}) {
+    std::vector<T> keys(n);
+    std::vector<T> queries;
+    for (auto &key : keys) {
+      key = static_cast<T>(gen() % (n + 1) * 2);
+      queries.push_back(key);
+      queries.push_back(static_cast<T>(key + 1));
+    }
+    queries.push_back(std::numeric_limits<T>::lowest());
+    queries.push_back(std::numeric_limits<T>::max());
+    check_search_index(keys, queries);
+  }
+}
+
+} // namespace
+
+TEST(SearchIndex, Empty) {
+  tiny_stl::static_search_index<int> index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0u, index.lower_bound(3));
+  EXPECT_EQ(0u, index.upper_bound(3));
+  EXPECT_FALSE(index.contains(3));
+}
+
+TEST(SearchIndex, Sizes) {
+  check_search_index_sizes<std::int32_t>();
+  check_search_index_sizes<std::uint32_t>();
+  check_search_index_sizes<std::int64_t>();
+  check_search_index_sizes<std::uint64_t>();
+  check_search_index_sizes<std::int16_t>();
+  check_search_index_sizes<unsigned char>();
+  check_search_index_sizes<float>();
+  check_search_index_sizes<double>();
+}
+
+TEST(SearchIndex, Extremes) {
+  // The padding after the last key must not be found as a key.
+  const int max = std::numeric_limits<int>::max();
+  check_search_index<int>({-5, 0, 3, 3, 9}, {max, -max - 1, 3});
+  check_search_index<int>({1, max, max}, {max, max - 1, 1, 0});
+  check_search_index<unsigned>({0, 1, 0x80000000u, 0xFFFFFFFFu},
+                               {0, 1, 2, 0x7FFFFFFFu, 0x80000000u,
+                                0xFFFFFFFEu, 0xFFFFFFFFu});
+
+  const double inf = std::numeric_limits<double>::infinity();
+  check_search_index<double>({-inf, -1.5, -0.0, 0.0, 2.5, inf, inf},
+                             {-inf, -2.0, 0.0, -0.0, 2.5, 3.0, inf,
+                              std::numeric_limits<double>::max()});
+}
+
+#endif // !TINY_STL__TEST__TEST_SEARCH_INDEX_HPP
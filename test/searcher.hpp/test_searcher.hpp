@@ -0,0 +1,150 @@
+#ifndef TINY_STL__TEST__TEST_SEARCHER_HPP
+#define TINY_STL__TEST__TEST_SEARCHER_HPP
+
+#include "algo.hpp"
+#include "searcher.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Search every pattern of `patterns` in `text` with all the searchers, and
+// compare the results with `std::search`.
+template <class T>
+void check_searchers(const std::vector<T> &text,
+                     const std::vector<std::vector<T>> &patterns) {
+  const T *first = text.data();
+  const T *last = first + text.size();
+  for (const auto &pattern : patterns) {
+    const T *p_first = pattern.data();
+    const T *p_last = p_first + pattern.size();
+    const T *expected = std::search(first, last, p_first, p_last);
+    const auto end = expected == last ? last : expected + pattern.size();
+
+    const tiny_stl::default_searcher<const T *> naive(p_first, p_last);
+    const tiny_stl::boyer_moore_horspool_searcher<const T *> horspool(
+        p_first, p_last);
+    const tiny_stl::boyer_moore_searcher<const T *> boyer_moore(p_first,
+                                                                p_last);
+    const tiny_stl::two_way_searcher<const T *> two_way(p_first, p_last);
+    EXPECT_EQ(expected, tiny_stl::search(first, last, naive));
+    EXPECT_EQ(expected, tiny_stl::search(first, last, horspool));
+    EXPECT_EQ(expected, tiny_stl::search(first, last, boyer_moore));
+    EXPECT_EQ(expected, tiny_stl::search(first, last, two_way));
+    EXPECT_EQ(end, boyer_moore(first, last).second);
+    EXPECT_EQ(expected, tiny_stl::search(first, last, p_first, p_last));
+  }
+}
+
+template <class T>
+std::vector<T> random_string(std::mt19937_64 &gen, size_t n, int alphabet) {
+  std::vector<T> result(n);
+  for (auto &c : result)
+    c = static_cast<T>('a' + gen() % alphabet);
+  return result;
+}
+
+} // namespace
+
+TEST(Searcher, Bytes) {
+  std::mt19937_64 gen(9);
+  // Small alphabets make periodic patterns and many partial matches.
+  for (int alphabet : {2, 4, 26}) {
+    const auto text = random_string<char>(gen, 5000, alphabet);
+    std::vector<std::vector<char>> patterns = {{}, {'a'}, {'z', 'z'}};
+    for (size_t m : {2u, 3u, 5u, 8u, 17u, 40u, 70u, 200u}) {
+      const size_t at = gen() % (text.size() - m);
+      patterns.emplace_back(text.begin() + at, text.begin() + at + m);
+      patterns.push_back(random_string<char>(gen, m, alphabet));
+    }
+    patterns.emplace_back(text.end() - 90, text.end());
+    patterns.emplace_back(text.begin(), text.end());
+    patterns.push_back(random_string<char>(gen, 6000, alphabet));
+    check_searchers(text, patterns);
+  }
+}
+
+TEST(Searcher, Periodic) {
+  const std::string text = std::string(300, 'a') + "b" + std::string(40, 'a') +
+                           "abaabaabaabaabab" + "aab";
+  std::vector<std::vector<char>> patterns;
+  for (const char *p : {"aaaab", "aaaa", "ab", "ba", "abaabaab", "baabab",
+                        "abaabaabaabaabab", "aabaab", "aab", "aaab"}) {
+    patterns.emplace_back(p, p + std::strlen(p));
+  }
+  check_searchers(std::vector<char>(text.begin(), text.end()), patterns);
+}
+
+TEST(Searcher, WideElements) {
+  std::mt19937_64 gen(10);
+  std::vector<int> text(4000);
+  for (auto &value : text)
+    value = static_cast<int>(gen() % 300) - 150;
+  std::vector<std::vector<int>> patterns;
+  for (size_t m : {1u, 2u, 6u, 31u, 500u}) {
+    const size_t at = gen() % (text.size() - m);
+    patterns.emplace_back(text.begin() + at, text.begin() + at + m);
+    std::vector<int> missing(m);
+    for (auto &value : missing)
+      value = static_cast<int>(gen() % 300) - 150;
+    patterns.push_back(missing);
+  }
+  check_searchers(text, patterns);
+}
+
+TEST(Searcher, CustomPredicate) {
+  // A case-insensitive search, the byte table is not used then.
+  struct lower_hash {
+    size_t operator()(char c) const {
+      return static_cast<size_t>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  };
+  struct equal_nocase {
+    bool operator()(char a, char b) const {
+      return std::tolower(static_cast<unsigned char>(a)) ==
+             std::tolower(static_cast<unsigned char>(b));
+    }
+  };
+  const std::string text = "The Quick Brown Fox Jumps Over The Lazy Dog";
+  const std::string pattern = "lazy DOG";
+  const tiny_stl::boyer_moore_horspool_searcher<const char *, lower_hash,
+                                                equal_nocase>
+      horspool(pattern.data(), pattern.data() + pattern.size());
+  const tiny_stl::boyer_moore_searcher<const char *, lower_hash, equal_nocase>
+      boyer_moore(pattern.data(), pattern.data() + pattern.size());
+  const char *first = text.data();
+  const char *last = first + text.size();
+  EXPECT_EQ(35, tiny_stl::search(first, last, horspool) - first);
+  EXPECT_EQ(35, tiny_stl::search(first, last, boyer_moore) - first);
+}
+
+TEST(Searcher, ByteSearcher) {
+  std::string text(100000, 'x');
+  const std::string needle = "needle in a haystack";
+  text.replace(77777, needle.size(), needle);
+  const tiny_stl::byte_searcher<const char *> searcher(
+      needle.data(), needle.data() + needle.size());
+  const char *first = text.data();
+  const auto found = searcher(first, first + text.size());
+  EXPECT_EQ(77777, found.first - first);
+  EXPECT_EQ(77777 + static_cast<long>(needle.size()), found.second - first);
+  const auto missing = searcher(first, first + 77777 + 10);
+  EXPECT_EQ(first + 77777 + 10, missing.first);
+
+  EXPECT_EQ(3u, tiny_stl::search_bytes(
+                    reinterpret_cast<const unsigned char *>("abcabd"), 6,
+                    reinterpret_cast<const unsigned char *>("abd"), 3));
+  EXPECT_EQ(6u, tiny_stl::search_bytes(
+                    reinterpret_cast<const unsigned char *>("abcabd"), 6,
+                    reinterpret_cast<const unsigned char *>("abe"), 3));
+}
+
+#endif // !TINY_STL__TEST__TEST_SEARCHER_HPP
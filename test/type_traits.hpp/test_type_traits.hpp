@@ -43,4 +43,42 @@ TEST(Test_TypeTraits, IsPair_Value) {
   EXPECT_TRUE((is_pair<pair<int, int>>::value));
 }
 
+namespace {
+struct OptedIn {
+  int x;
+  int y;
+};
+struct NotOptedIn {
+  int x;
+};
+} // namespace
+
+template <>
+struct tiny_stl::is_zero_initializable<OptedIn> : tiny_stl::true_type {};
+
+template <>
+struct tiny_stl::is_bitwise_comparable<OptedIn> : tiny_stl::true_type {};
+
+TEST(Test_TypeTraits, IsZeroInitializable_Value) {
+  using tiny_stl::is_zero_initializable_v;
+
+  EXPECT_TRUE(is_zero_initializable_v<int>);
+  EXPECT_TRUE(is_zero_initializable_v<const double>);
+  EXPECT_TRUE(is_zero_initializable_v<int *>);
+  EXPECT_TRUE(is_zero_initializable_v<OptedIn>);
+  EXPECT_FALSE(is_zero_initializable_v<NotOptedIn>);
+  EXPECT_FALSE(is_zero_initializable_v<int NotOptedIn::*>);
+}
+
+TEST(Test_TypeTraits, IsBitwiseComparable_Value) {
+  using tiny_stl::is_bitwise_comparable_v;
+
+  EXPECT_TRUE(is_bitwise_comparable_v<unsigned>);
+  EXPECT_TRUE(is_bitwise_comparable_v<const char>);
+  EXPECT_TRUE(is_bitwise_comparable_v<int *>);
+  EXPECT_TRUE(is_bitwise_comparable_v<OptedIn>);
+  EXPECT_FALSE(is_bitwise_comparable_v<double>);
+  EXPECT_FALSE(is_bitwise_comparable_v<NotOptedIn>);
+}
+
 #endif // !TINY_STL__TEST__TEST_TYPE_TRAITS_HPP
\ No newline at end of file
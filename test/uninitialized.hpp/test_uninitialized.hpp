@@ -4,6 +4,29 @@
 #include "uninitialized.hpp"
 
 #include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ThrowOnCopy {
+  static int live;
+  int value;
+  ThrowOnCopy(int v = 0) : value(v) { ++live; }
+  ThrowOnCopy(const ThrowOnCopy &other) : value(other.value) {
+    if (value < 0) {
+      throw std::runtime_error("copy");
+    }
+    ++live;
+  }
+  ~ThrowOnCopy() { --live; }
+};
+
+int ThrowOnCopy::live = 0;
+
+} // namespace
 
 TEST(Uninitialized, UncheckedUninitCopy_TriviallyCopyAssignable) {
   int arr1[] = {1, 2, 3, 4, 5};
@@ -75,6 +98,15 @@ TEST(Uninitialized, UncheckedUninitFillN_NotTriviallyCopyAssignable) {
   }
 }
 
+TEST(Uninitialized, UninitializedFillN_Zero) {
+  long arr1[] = {1, 2, 3, 4, 5};
+  EXPECT_EQ(tiny_stl::uninitialized_fill_n(arr1, 4, 0L), arr1 + 4);
+  long result[] = {0, 0, 0, 0, 5};
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(arr1[i], result[i]);
+  }
+}
+
 TEST(Uninitialized, UninitializedMove_TriviallyMoveAssignable) {
   int arr1[] = {1, 2, 3, 4, 5};
   int arr2[sizeof(arr1) / sizeof(int)];
@@ -89,7 +121,7 @@ TEST(Uninitialized, UninitializedMove_NotTriviallyMoveAssignable) {
   std::string arr2[sizeof(arr1) / sizeof(std::string)];
   tiny_stl::unchecked_uninit_move(arr1, arr1 + 5, arr2, std::false_type());
   for (int i = 0; i < 5; ++i) {
-    EXPECT_EQ(arr1[i], arr2[i]);
+    EXPECT_EQ(std::to_string(i + 1), arr2[i]);
   }
 }
 
@@ -107,8 +139,89 @@ TEST(Uninitialized, UninitializedMoveN_NotTriviallyMoveAssignable) {
   std::string arr2[sizeof(arr1) / sizeof(std::string)];
   tiny_stl::unchecked_uninit_move_n(arr1, 3, arr2, std::false_type());
   for (int i = 0; i < 3; ++i) {
-    EXPECT_EQ(arr1[i], arr2[i]);
+    EXPECT_EQ(std::to_string(i + 1), arr2[i]);
+  }
+}
+
+TEST(Uninitialized, UninitializedRelocateMove) {
+  // Above the streaming threshold, so the non-temporal path is taken.
+  const size_t n = tiny_stl::kStreamingCopyBytes / sizeof(int) + 3;
+  std::vector<int> src(n);
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = static_cast<int>(i);
+  }
+  std::unique_ptr<int[]> dest(new int[n]);
+  EXPECT_EQ(tiny_stl::uninitialized_relocate_move(src.data(), src.data() + n,
+                                                  dest.get()),
+            dest.get() + n);
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(src[i], dest[i]);
+  }
+
+  std::string strs[2] = {"a", "b"};
+  auto raw = static_cast<std::string *>(::operator new(2 * sizeof(std::string)));
+  tiny_stl::uninitialized_relocate_move(strs, strs + 2, raw);
+  EXPECT_EQ("a", raw[0]);
+  EXPECT_EQ("b", raw[1]);
+  tiny_stl::destroy(raw, raw + 2);
+  ::operator delete(raw);
+}
+
+TEST(Uninitialized, UninitializedCopy_Parallel) {
+  const size_t n = 1 << 20;
+  std::vector<int> src(n);
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = static_cast<int>(i);
+  }
+  std::unique_ptr<int[]> dest(new int[n]);
+  EXPECT_EQ(tiny_stl::uninitialized_copy(tiny_stl::par, src.data(),
+                                         src.data() + n, dest.get()),
+            dest.get() + n);
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(src[i], dest[i]);
+  }
+}
+
+TEST(Uninitialized, UninitializedFillN_Parallel) {
+  const size_t n = 1 << 16;
+  auto raw = static_cast<std::string *>(::operator new(n * sizeof(std::string)));
+  EXPECT_EQ(tiny_stl::uninitialized_fill_n(tiny_stl::par, raw, n,
+                                           std::string("value")),
+            raw + n);
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ("value", raw[i]);
+  }
+  tiny_stl::destroy(raw, raw + n);
+  ::operator delete(raw);
+}
+
+TEST(Uninitialized, UninitializedMove_Parallel) {
+  const size_t n = 1 << 16;
+  std::vector<std::string> src(n, "value");
+  auto raw = static_cast<std::string *>(::operator new(n * sizeof(std::string)));
+  tiny_stl::uninitialized_move(tiny_stl::par, src.data(), src.data() + n, raw);
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ("value", raw[i]);
+  }
+  tiny_stl::destroy(raw, raw + n);
+  ::operator delete(raw);
+}
+
+TEST(Uninitialized, UninitializedCopy_Parallel_Rollback) {
+  const size_t n = 1 << 16;
+  {
+    std::vector<ThrowOnCopy> src(n);
+    src[n - 10].value = -1;
+    const int live = ThrowOnCopy::live;
+    auto raw =
+        static_cast<ThrowOnCopy *>(::operator new(n * sizeof(ThrowOnCopy)));
+    EXPECT_THROW(tiny_stl::uninitialized_copy(tiny_stl::par, src.data(),
+                                              src.data() + n, raw),
+                 std::runtime_error);
+    EXPECT_EQ(live, ThrowOnCopy::live);
+    ::operator delete(raw);
   }
+  EXPECT_EQ(0, ThrowOnCopy::live);
 }
 
 #endif // ! TINY_STL__TEST__TEST_UNINItiALIZED_HPP
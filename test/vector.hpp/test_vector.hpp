@@ -0,0 +1,109 @@
+#ifndef TINY_STL__TEST__TEST_VECTOR_HPP
+#define TINY_STL__TEST__TEST_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+TEST(Vector, Constructor_ValueInit) {
+  tiny_stl::vector<double> vec(100000);
+  EXPECT_EQ(100000, vec.size());
+  for (auto val : vec) {
+    EXPECT_EQ(0.0, val);
+  }
+}
+
+TEST(Vector, Constructor_ValueInit_Realloc) {
+  // The zeroed storage is released by whichever vector owns it last.
+  tiny_stl::vector<double> vec(1000);
+  vec.reserve(4000);
+  EXPECT_EQ(1000, vec.size());
+  EXPECT_EQ(0.0, vec[999]);
+
+  tiny_stl::vector<double> zeros(1000, 0.0);
+  tiny_stl::vector<double> ones(10, 1.0);
+  zeros.swap(ones);
+  EXPECT_EQ(1000, ones.size());
+  ones.insert(ones.end(), 5000, 2.0);
+  EXPECT_EQ(6000, ones.size());
+  EXPECT_EQ(0.0, ones[999]);
+  EXPECT_EQ(2.0, ones[5999]);
+}
+
+TEST(Vector, Constructor_Fill) {
+  tiny_stl::vector<int> zeros(1000, 0);
+  tiny_stl::vector<int> ones(1000, 1);
+  tiny_stl::vector<std::string> strs(10, "str");
+  for (size_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(0, zeros[i]);
+    EXPECT_EQ(1, ones[i]);
+  }
+  for (auto &str : strs) {
+    EXPECT_EQ("str", str);
+  }
+}
+
+TEST(Vector, Assign_Fill) {
+  tiny_stl::vector<int> vec(10, 1);
+  vec.assign(5, 2);
+  EXPECT_EQ(5, vec.size());
+  for (auto val : vec) {
+    EXPECT_EQ(2, val);
+  }
+  vec.assign(8, 3);
+  EXPECT_EQ(8, vec.size());
+  for (auto val : vec) {
+    EXPECT_EQ(3, val);
+  }
+  vec.assign(1000, 4);
+  EXPECT_EQ(1000, vec.size());
+  for (auto val : vec) {
+    EXPECT_EQ(4, val);
+  }
+}
+
+TEST(Vector, PushBack) {
+  tiny_stl::vector<std::string> vec;
+  for (int i = 0; i < 100; ++i) {
+    const std::string str = std::to_string(i);
+    vec.push_back(str);
+  }
+  EXPECT_EQ(100, vec.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(std::to_string(i), vec[i]);
+  }
+}
+
+TEST(Vector, EmplaceBack_MoveOnly) {
+  tiny_stl::vector<std::unique_ptr<int>> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.emplace_back(new int(i));
+  }
+  EXPECT_EQ(100, vec.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, *vec[i]);
+  }
+}
+
+TEST(Vector, Compare) {
+  tiny_stl::vector<unsigned> vec1(100, 7);
+  tiny_stl::vector<unsigned> vec2(100, 7);
+  tiny_stl::vector<unsigned> vec3(101, 7);
+  EXPECT_TRUE(vec1 == vec2);
+  EXPECT_FALSE(vec1 == vec3);
+  EXPECT_TRUE(vec1 < vec3);
+  EXPECT_FALSE(vec1 < vec2);
+  vec2[60] = 1u << 31;
+  EXPECT_TRUE(vec1 != vec2);
+  EXPECT_TRUE(vec1 < vec2);
+  EXPECT_TRUE(vec2 > vec3);
+
+  tiny_stl::vector<std::string> strs1(3, "a");
+  tiny_stl::vector<std::string> strs2(3, "b");
+  EXPECT_TRUE(strs1 < strs2);
+  EXPECT_FALSE(strs1 == strs2);
+}
+
+#endif // !TINY_STL__TEST__TEST_VECTOR_HPP
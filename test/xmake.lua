@@ -3,4 +3,15 @@ target("test")
     set_kind("binary")
     add_files("*.cpp")
     add_packages("gtest")
-target_end()
\ No newline at end of file
+    add_syslinks("pthread")
+target_end()
+-- the same tests with the AVX2 paths of the headers compiled in
+if is_arch("x86_64", "x64") then
+    target("test_avx2")
+        set_kind("binary")
+        add_files("*.cpp")
+        add_cxxflags("-mavx2")
+        add_packages("gtest")
+        add_syslinks("pthread")
+    target_end()
+end
@@ -18,6 +18,9 @@ add_includedirs("include")
 -- test target
 includes("test")
 
+-- benchmark targets
+includes("bench")
+
 -- doc target
 includes("doc")
 